@@ -15,7 +15,9 @@
 */
 
 #include <tet_api.h>
+#include <string.h>
 #include <locations.h>
+#include <location_nmea.h>
 #include <glib.h>
 
 enum {
@@ -32,6 +34,10 @@ void (*tet_cleanup) (void) = cleanup;
 static void utc_location_gps_status_get_nmea_p(void);
 static void utc_location_gps_status_get_nmea_n(void);
 static void utc_location_gps_status_get_nmea_n_02(void);
+static void utc_location_gps_status_foreach_nmea_sentence_p(void);
+static void utc_location_gps_status_foreach_nmea_sentence_n(void);
+static void utc_location_gps_status_nmea_parser_feed_p(void);
+static void utc_location_gps_status_nmea_parser_feed_n(void);
 static void utc_location_gps_status_get_nmea_n_03(void);
 static void utc_location_gps_status_get_satellite_p(void);
 static void utc_location_gps_status_get_satellite_n(void);
@@ -59,6 +65,10 @@ struct tet_testlist tet_testlist[] = {
 	{utc_location_gps_status_get_nmea_p, POSITIVE_TC_IDX},
 	{utc_location_gps_status_get_nmea_n, NEGATIVE_TC_IDX},
 	{utc_location_gps_status_get_nmea_n_02, NEGATIVE_TC_IDX},
+	{utc_location_gps_status_foreach_nmea_sentence_p, POSITIVE_TC_IDX},
+	{utc_location_gps_status_foreach_nmea_sentence_n, NEGATIVE_TC_IDX},
+	{utc_location_gps_status_nmea_parser_feed_p, POSITIVE_TC_IDX},
+	{utc_location_gps_status_nmea_parser_feed_n, NEGATIVE_TC_IDX},
 //      {utc_location_gps_status_get_nmea_n_03, NEGATIVE_TC_IDX}, //Can't check created location_manager_h
 	{utc_location_gps_status_get_satellite_p, POSITIVE_TC_IDX},
 	{utc_location_gps_status_get_satellite_n, NEGATIVE_TC_IDX},
@@ -211,6 +221,181 @@ static void utc_location_gps_status_get_nmea_n_02(void)
 
 }
 
+static bool capi_nmea_sentence_cb(const char *sentence, int length, void *user_data)
+{
+	dts_message(__func__, "%.*s", length, sentence);
+	return true;
+}
+
+static void utc_location_gps_status_foreach_nmea_sentence_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	ret = gps_status_foreach_nmea_sentence(manager, capi_nmea_sentence_cb, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_gps_status_foreach_nmea_sentence_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	ret = gps_status_foreach_nmea_sentence(manager, NULL, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+#define NMEA_RECORD_MAX 8
+
+typedef struct {
+	location_nmea_record_s records[NMEA_RECORD_MAX];
+	int count;
+} nmea_records_s;
+
+static void capi_nmea_record_cb(const location_nmea_record_s *record, void *user_data)
+{
+	nmea_records_s *records = (nmea_records_s *) user_data;
+	if (records->count < NMEA_RECORD_MAX)
+		records->records[records->count] = *record;
+	records->count++;
+}
+
+/* The sentences of nmea_stream, with the GGA of a bad checksum dropped */
+static const char *nmea_stream =
+	"$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+	"$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n"
+	"$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*48\r\n"
+	"$GPGSV,2,2,06,01,40,083,46,02,17,308,,,,,,,,,*7C\r\n"
+	"$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48\r\n"
+	"$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+
+static int nmea_mismatches;
+
+static void __check_nmea_field(const char *api_name, const char *field, double actual, double expected)
+{
+	double difference = actual - expected;
+	if (difference > 0.0001 || difference < -0.0001) {
+		dts_message(api_name, "%s : %f, expected %f", field, actual, expected);
+		nmea_mismatches++;
+	}
+}
+
+static void __check_nmea_records(const char *api_name, const nmea_records_s *records, unsigned int error_count)
+{
+	__check_nmea_field(api_name, "record count", records->count, 5);
+	__check_nmea_field(api_name, "error count", error_count, 1);
+	if (records->count != 5)
+		return;
+
+	const location_nmea_record_s *record = &records->records[0];
+	__check_nmea_field(api_name, "RMC type", record->type, LOCATIONS_NMEA_RMC);
+	__check_nmea_field(api_name, "RMC talker", strcmp(record->talker, "GP"), 0);
+	__check_nmea_field(api_name, "RMC time", record->data.rmc.utc_time, 12 * 3600 + 35 * 60 + 19);
+	__check_nmea_field(api_name, "RMC valid", record->data.rmc.is_valid, true);
+	__check_nmea_field(api_name, "RMC latitude", record->data.rmc.latitude, 48 + 7.038 / 60);
+	__check_nmea_field(api_name, "RMC longitude", record->data.rmc.longitude, 11 + 31.0 / 60);
+	__check_nmea_field(api_name, "RMC speed", record->data.rmc.speed, 22.4 * 1.852);
+	__check_nmea_field(api_name, "RMC direction", record->data.rmc.direction, 84.4);
+	__check_nmea_field(api_name, "RMC day", record->data.rmc.day, 23);
+	__check_nmea_field(api_name, "RMC month", record->data.rmc.month, 3);
+	__check_nmea_field(api_name, "RMC year", record->data.rmc.year, 1994);
+
+	record = &records->records[1];
+	__check_nmea_field(api_name, "GSA type", record->type, LOCATIONS_NMEA_GSA);
+	__check_nmea_field(api_name, "GSA automatic", record->data.gsa.is_automatic, true);
+	__check_nmea_field(api_name, "GSA fix type", record->data.gsa.fix_type, 3);
+	__check_nmea_field(api_name, "GSA PRN count", record->data.gsa.num_of_prn, 5);
+	__check_nmea_field(api_name, "GSA PRN", record->data.gsa.prn[2], 9);
+	__check_nmea_field(api_name, "GSA PRN", record->data.gsa.prn[4], 24);
+	__check_nmea_field(api_name, "GSA PDOP", record->data.gsa.pdop, 2.5);
+	__check_nmea_field(api_name, "GSA HDOP", record->data.gsa.hdop, 1.3);
+	__check_nmea_field(api_name, "GSA VDOP", record->data.gsa.vdop, 2.1);
+
+	/* The two empty satellite blocks padding the message are skipped */
+	record = &records->records[2];
+	__check_nmea_field(api_name, "GSV type", record->type, LOCATIONS_NMEA_GSV);
+	__check_nmea_field(api_name, "GSV messages", record->data.gsv.num_of_messages, 2);
+	__check_nmea_field(api_name, "GSV message number", record->data.gsv.message_number, 2);
+	__check_nmea_field(api_name, "GSV in view", record->data.gsv.num_of_inview, 6);
+	__check_nmea_field(api_name, "GSV satellites", record->data.gsv.num_of_satellites, 2);
+	__check_nmea_field(api_name, "GSV PRN", record->data.gsv.satellites[0].prn, 1);
+	__check_nmea_field(api_name, "GSV elevation", record->data.gsv.satellites[0].elevation, 40);
+	__check_nmea_field(api_name, "GSV azimuth", record->data.gsv.satellites[0].azimuth, 83);
+	__check_nmea_field(api_name, "GSV SNR", record->data.gsv.satellites[0].snr, 46);
+	__check_nmea_field(api_name, "GSV PRN", record->data.gsv.satellites[1].prn, 2);
+	__check_nmea_field(api_name, "GSV azimuth", record->data.gsv.satellites[1].azimuth, 308);
+	__check_nmea_field(api_name, "GSV SNR", record->data.gsv.satellites[1].snr, -1);
+
+	record = &records->records[3];
+	__check_nmea_field(api_name, "VTG type", record->type, LOCATIONS_NMEA_VTG);
+	__check_nmea_field(api_name, "VTG direction", record->data.vtg.direction, 54.7);
+	__check_nmea_field(api_name, "VTG magnetic direction", record->data.vtg.magnetic_direction, 34.4);
+	__check_nmea_field(api_name, "VTG speed", record->data.vtg.speed, 10.2);
+
+	record = &records->records[4];
+	__check_nmea_field(api_name, "GGA type", record->type, LOCATIONS_NMEA_GGA);
+	__check_nmea_field(api_name, "GGA time", record->data.gga.utc_time, 12 * 3600 + 35 * 60 + 19);
+	__check_nmea_field(api_name, "GGA latitude", record->data.gga.latitude, 48 + 7.038 / 60);
+	__check_nmea_field(api_name, "GGA longitude", record->data.gga.longitude, 11 + 31.0 / 60);
+	__check_nmea_field(api_name, "GGA quality", record->data.gga.quality, 1);
+	__check_nmea_field(api_name, "GGA satellites", record->data.gga.num_of_sat_used, 8);
+	__check_nmea_field(api_name, "GGA HDOP", record->data.gga.hdop, 0.9);
+	__check_nmea_field(api_name, "GGA altitude", record->data.gga.altitude, 545.4);
+	__check_nmea_field(api_name, "GGA geoid separation", record->data.gga.geoid_separation, 46.9);
+}
+
+/* Feeds nmea_stream in chunks of chunk_length bytes, 0 for all at once */
+static int __feed_nmea_stream(const char *api_name, int chunk_length)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	int length = strlen(nmea_stream);
+	int i;
+	unsigned int error_count = 0;
+	nmea_records_s records;
+	location_nmea_parser_h parser;
+
+	memset(&records, 0, sizeof(nmea_records_s));
+	ret = location_nmea_parser_create(capi_nmea_record_cb, &records, &parser);
+	if (ret != LOCATIONS_ERROR_NONE)
+		return ret;
+
+	if (chunk_length == 0)
+		chunk_length = length;
+	for (i = 0; i < length && ret == LOCATIONS_ERROR_NONE; i += chunk_length)
+		ret = location_nmea_parser_feed(parser, nmea_stream + i, (length - i < chunk_length) ? length - i : chunk_length);
+	if (ret == LOCATIONS_ERROR_NONE)
+		ret = location_nmea_parser_get_error_count(parser, &error_count);
+	location_nmea_parser_destroy(parser);
+
+	if (ret == LOCATIONS_ERROR_NONE)
+		__check_nmea_records(api_name, &records, error_count);
+	return ret;
+}
+
+static void utc_location_gps_status_nmea_parser_feed_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	nmea_mismatches = 0;
+	ret = __feed_nmea_stream(__func__, 0);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_nmea_parser_feed() is failed");
+
+	/* Every sentence cut at every byte */
+	ret = __feed_nmea_stream(__func__, 1);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_nmea_parser_feed() is failed with 1 byte chunks");
+
+	/* Cuts within the checksum and the line end */
+	ret = __feed_nmea_stream(__func__, 7);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_nmea_parser_feed() is failed with 7 byte chunks");
+
+	validate_eq(__func__, nmea_mismatches, 0);
+}
+
+static void utc_location_gps_status_nmea_parser_feed_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_nmea_parser_h parser;
+
+	ret = location_nmea_parser_create(NULL, NULL, &parser);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
 static void utc_location_gps_status_get_nmea_n_03(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
@@ -17,6 +17,7 @@
 #include <tet_api.h>
 #include <locations.h>
 #include <glib.h>
+#include <time.h>
 
 enum {
 	POSITIVE_TC_IDX = 0x01,
@@ -40,6 +41,10 @@ static void utc_location_location_manager_create_n_03(void);
 static void utc_location_location_manager_create_n_04(void);
 static void utc_location_location_manager_create_n_05(void);
 static void utc_location_location_manager_create_n_06(void);
+static void utc_location_location_manager_create_shared_p(void);
+static void utc_location_location_manager_create_shared_n(void);
+static void utc_location_location_manager_create_shared_p_02(void);
+static void utc_location_location_manager_start_stop_cycle_p(void);
 static void utc_location_location_manager_add_boundary_p(void);
 static void utc_location_location_manager_add_boundary_n(void);
 static void utc_location_location_manager_add_boundary_n_02(void);
@@ -55,6 +60,11 @@ static void utc_location_location_manager_remove_boundary_n(void);
 static void utc_location_location_manager_remove_boundary_n_02(void);
 static void utc_location_location_manager_remove_boundary_n_03(void);
 static void utc_location_location_manager_remove_boundary_n_04(void);
+static void utc_location_location_manager_add_boundaries_p(void);
+static void utc_location_location_manager_add_boundaries_n(void);
+static void utc_location_location_manager_remove_boundaries_n(void);
+static void utc_location_location_manager_replace_boundaries_p(void);
+static void utc_location_location_manager_replace_boundaries_n(void);
 static void utc_location_location_manager_get_method_p(void);
 static void utc_location_location_manager_get_method_n(void);
 static void utc_location_location_manager_get_method_n_02(void);
@@ -96,11 +106,63 @@ static void utc_location_location_bounds_contains_coordinates_p(void);
 static void utc_location_location_bounds_contains_coordinates_p_02(void);
 static void utc_location_location_bounds_contains_coordinates_n(void);
 static void utc_location_location_bounds_contains_coordinates_n_02(void);
+static void utc_location_location_bounds_contains_coordinates_batch_p(void);
+static void utc_location_location_bounds_contains_coordinates_batch_n(void);
+static void utc_location_location_bounds_get_bounding_box_p(void);
+static void utc_location_location_bounds_get_bounding_box_n(void);
+static void utc_location_location_bounds_prepare_p(void);
+static void utc_location_location_bounds_prepare_n(void);
+static void utc_location_location_bounds_prepare_n_02(void);
+static void utc_location_location_bounds_set_foreach_containing_bounds_p(void);
+static void utc_location_location_bounds_set_foreach_containing_bounds_n(void);
+static void utc_location_location_bounds_set_remove_p(void);
+static void utc_location_location_bounds_set_remove_n(void);
 static void utc_location_location_manager_get_last_accuracy_p(void);
 static void utc_location_location_manager_get_last_accuracy_n(void);
 static void utc_location_location_manager_get_last_accuracy_n_02(void);
 static void utc_location_location_manager_get_last_accuracy_n_03(void);
 static void utc_location_location_manager_get_last_accuracy_n_04(void);
+static void utc_location_location_manager_get_fix_p(void);
+static void utc_location_location_manager_get_fix_n(void);
+static void utc_location_location_manager_get_fix_n_02(void);
+static void utc_location_location_manager_predict_position_p(void);
+static void utc_location_location_manager_predict_position_n(void);
+static void utc_location_location_manager_predict_position_n_02(void);
+static void utc_location_location_manager_set_position_updated_ns_cb_p(void);
+static void utc_location_location_manager_set_position_updated_ns_cb_n(void);
+static void utc_location_location_manager_get_last_position_time_p(void);
+static void utc_location_location_manager_get_last_position_time_n(void);
+static void utc_location_location_manager_get_last_velocity_time_n(void);
+static void utc_location_location_manager_set_dispatch_thread_enabled_p(void);
+static void utc_location_location_manager_set_dispatch_thread_enabled_n(void);
+static void utc_location_location_manager_get_dispatch_dropped_count_p(void);
+static void utc_location_location_manager_get_dispatch_dropped_count_n(void);
+static void utc_location_location_manager_set_duty_cycle_p(void);
+static void utc_location_location_manager_set_duty_cycle_n(void);
+static void utc_location_location_manager_get_duty_cycle_interval_n(void);
+static void utc_location_location_manager_add_position_updated_listener_p(void);
+static void utc_location_location_manager_add_position_updated_listener_n(void);
+static void utc_location_location_manager_remove_listener_n(void);
+static void utc_location_location_manager_set_fix_cache_enabled_p(void);
+static void utc_location_location_manager_set_fix_cache_enabled_n(void);
+static void utc_location_location_manager_set_smoothing_enabled_p(void);
+static void utc_location_location_manager_set_smoothing_enabled_n(void);
+static void utc_location_location_manager_get_smoothed_fix_n(void);
+static void utc_location_location_manager_get_smoothed_fix_n_02(void);
+static void utc_location_location_manager_set_position_distance_filter_p(void);
+static void utc_location_location_manager_set_position_distance_filter_n(void);
+static void utc_location_location_manager_add_geofence_p(void);
+static void utc_location_location_manager_add_geofence_n(void);
+static void utc_location_location_manager_remove_geofence_n(void);
+static void utc_location_location_manager_set_geofence_event_cb_p(void);
+static void utc_location_location_manager_set_geofence_event_cb_n(void);
+static void utc_location_location_manager_set_batch_updated_cb_p(void);
+static void utc_location_location_manager_set_batch_updated_cb_n(void);
+static void utc_location_location_manager_set_batch_updated_cb_n_02(void);
+static void utc_location_location_manager_get_history_p(void);
+static void utc_location_location_manager_get_history_n(void);
+static void utc_location_location_manager_get_history_since_p(void);
+static void utc_location_location_manager_get_history_since_n(void);
 static void utc_location_location_manager_get_last_position_p(void);
 static void utc_location_location_manager_get_last_position_n(void);
 static void utc_location_location_manager_get_last_position_n_02(void);
@@ -119,6 +181,10 @@ static void utc_location_location_manager_is_supported_method_p_03(void);
 static void utc_location_location_manager_is_supported_method_p_04(void);
 static void utc_location_location_manager_is_supported_method_n(void);
 static void utc_location_location_manager_is_supported_method_n_02(void);
+static void utc_location_location_manager_get_distances_p(void);
+static void utc_location_location_manager_get_distances_n(void);
+static void utc_location_location_manager_get_distances_from_p(void);
+static void utc_location_location_manager_get_distances_from_n(void);
 static void utc_location_location_manager_send_command_p(void);
 static void utc_location_location_manager_send_command_n(void);
 static void utc_location_location_manager_destroy_p(void);
@@ -137,6 +203,10 @@ struct tet_testlist tet_testlist[] = {
 	{utc_location_location_manager_create_n_04, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_create_n_05, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_create_n_06, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_create_shared_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_create_shared_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_create_shared_p_02, POSITIVE_TC_IDX},
+	{utc_location_location_manager_start_stop_cycle_p, POSITIVE_TC_IDX},
 	{utc_location_location_manager_add_boundary_p, POSITIVE_TC_IDX},
 	{utc_location_location_manager_add_boundary_n, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_add_boundary_n_02, NEGATIVE_TC_IDX},
@@ -152,6 +222,11 @@ struct tet_testlist tet_testlist[] = {
 	{utc_location_location_manager_remove_boundary_n_02, NEGATIVE_TC_IDX},
 //      { utc_location_location_manager_remove_boundary_n_03, NEGATIVE_TC_IDX },  // Can't check created location_manager_h
 	{utc_location_location_manager_remove_boundary_n_04, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_add_boundaries_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_add_boundaries_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_remove_boundaries_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_replace_boundaries_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_replace_boundaries_n, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_get_method_p, POSITIVE_TC_IDX},
 	{utc_location_location_manager_get_method_n, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_get_method_n_02, NEGATIVE_TC_IDX},
@@ -193,11 +268,63 @@ struct tet_testlist tet_testlist[] = {
 	{utc_location_location_bounds_contains_coordinates_p_02, POSITIVE_TC_IDX},
 	{utc_location_location_bounds_contains_coordinates_n, NEGATIVE_TC_IDX},
 	{utc_location_location_bounds_contains_coordinates_n_02, NEGATIVE_TC_IDX},
+	{utc_location_location_bounds_contains_coordinates_batch_p, POSITIVE_TC_IDX},
+	{utc_location_location_bounds_contains_coordinates_batch_n, NEGATIVE_TC_IDX},
+	{utc_location_location_bounds_get_bounding_box_p, POSITIVE_TC_IDX},
+	{utc_location_location_bounds_get_bounding_box_n, NEGATIVE_TC_IDX},
+	{utc_location_location_bounds_prepare_p, POSITIVE_TC_IDX},
+	{utc_location_location_bounds_prepare_n, NEGATIVE_TC_IDX},
+	{utc_location_location_bounds_prepare_n_02, NEGATIVE_TC_IDX},
+	{utc_location_location_bounds_set_foreach_containing_bounds_p, POSITIVE_TC_IDX},
+	{utc_location_location_bounds_set_foreach_containing_bounds_n, NEGATIVE_TC_IDX},
+	{utc_location_location_bounds_set_remove_p, POSITIVE_TC_IDX},
+	{utc_location_location_bounds_set_remove_n, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_get_last_accuracy_p, POSITIVE_TC_IDX},
 	{utc_location_location_manager_get_last_accuracy_n, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_get_last_accuracy_n_02, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_get_last_accuracy_n_03, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_get_last_accuracy_n_04, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_fix_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_get_fix_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_fix_n_02, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_predict_position_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_predict_position_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_predict_position_n_02, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_set_position_updated_ns_cb_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_set_position_updated_ns_cb_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_last_position_time_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_get_last_position_time_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_last_velocity_time_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_set_dispatch_thread_enabled_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_set_dispatch_thread_enabled_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_dispatch_dropped_count_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_get_dispatch_dropped_count_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_set_duty_cycle_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_set_duty_cycle_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_duty_cycle_interval_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_add_position_updated_listener_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_add_position_updated_listener_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_remove_listener_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_set_fix_cache_enabled_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_set_fix_cache_enabled_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_set_smoothing_enabled_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_set_smoothing_enabled_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_smoothed_fix_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_smoothed_fix_n_02, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_set_position_distance_filter_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_set_position_distance_filter_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_add_geofence_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_add_geofence_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_remove_geofence_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_set_geofence_event_cb_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_set_geofence_event_cb_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_set_batch_updated_cb_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_set_batch_updated_cb_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_set_batch_updated_cb_n_02, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_history_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_get_history_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_history_since_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_get_history_since_n, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_get_last_position_p, POSITIVE_TC_IDX},
 	{utc_location_location_manager_get_last_position_n, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_get_last_position_n_02, NEGATIVE_TC_IDX},
@@ -216,6 +343,10 @@ struct tet_testlist tet_testlist[] = {
 	{utc_location_location_manager_is_supported_method_p_04, POSITIVE_TC_IDX},
 	{utc_location_location_manager_is_supported_method_n, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_is_supported_method_n_02, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_distances_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_get_distances_n, NEGATIVE_TC_IDX},
+	{utc_location_location_manager_get_distances_from_p, POSITIVE_TC_IDX},
+	{utc_location_location_manager_get_distances_from_n, NEGATIVE_TC_IDX},
 	{utc_location_location_manager_destroy_p, POSITIVE_TC_IDX},
 	{utc_location_location_manager_destroy_n, NEGATIVE_TC_IDX},
 //      { utc_location_location_manager_destroy_n_02, NEGATIVE_TC_IDX }, // Can't check created location_manager_h
@@ -314,6 +445,31 @@ static location_bounds_h bounds_rect;
 static location_bounds_h bounds_circle;
 static location_bounds_h bounds_poly;
 
+static bool position_updated = false;
+
+static void __position_updated_cb(double latitude, double longitude, double altitude, time_t timestamp, void *user_data)
+{
+	position_updated = true;
+}
+
+static void wait_for_position(char *api_name)
+{
+	int timeout = 0;
+	int listener_id;
+	position_updated = false;
+	location_manager_add_position_updated_listener(manager, __position_updated_cb, NULL, &listener_id);
+	for (timeout; timeout < 60; timeout++) {
+		if (position_updated) {
+			dts_message(api_name, "Position Updated!!!!");
+			break;
+		} else {
+			dts_message(api_name, "No Position!!!!");
+			sleep(1);
+		}
+	}
+	location_manager_remove_listener(manager, listener_id);
+}
+
 static void startup(void)
 {
 	g_setenv("PKG_NAME", "com.samsung.capi-location-manager-test", 1);
@@ -521,6 +677,133 @@ static void utc_location_location_manager_create_n_06(void)
 
 }
 
+static void utc_location_location_manager_create_shared_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_manager_h manager_02, manager_03;
+
+	ret = location_manager_create_shared(LOCATIONS_METHOD_GPS, &manager_02);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_create_shared() is failed");
+
+	ret = location_manager_create_shared(LOCATIONS_METHOD_GPS, &manager_03);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_create_shared() is failed");
+
+	location_manager_destroy(manager_02);
+	ret = location_manager_destroy(manager_03);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_create_shared_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_manager_h manager_02;
+
+	ret = location_manager_create_shared(LOCATIONS_METHOD_CPS + 1, &manager_02);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static location_manager_h shared_manager;
+static bool shared_destroyed = false;
+static int shared_destroy_ret = LOCATIONS_ERROR_NONE;
+
+static void __shared_destroy_cb(location_service_state_e state, void *user_data)
+{
+	if (state != LOCATIONS_SERVICE_ENABLED || shared_manager == NULL)
+		return;
+	shared_destroy_ret = location_manager_destroy(shared_manager);
+	shared_manager = NULL;
+	shared_destroyed = true;
+}
+
+static void utc_location_location_manager_create_shared_p_02(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	int timeout;
+	location_manager_h manager_02;
+
+	ret = location_manager_create_shared(LOCATIONS_METHOD_GPS, &shared_manager);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_create_shared() is failed");
+
+	ret = location_manager_set_service_state_changed_cb(shared_manager, __shared_destroy_cb, NULL);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_set_service_state_changed_cb() is failed");
+
+	/* The last manager of the session destroys itself from its callback */
+	shared_destroyed = false;
+	ret = location_manager_start(shared_manager);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_start() is failed");
+	for (timeout = 0; timeout < 60 && !shared_destroyed; timeout++)
+		sleep(1);
+	if (!shared_destroyed) {
+		location_manager_h manager_03 = shared_manager;
+		shared_manager = NULL;
+		location_manager_destroy(manager_03);
+	}
+	validate_and_next(__func__, shared_destroyed, true, "location_service_state_changed_cb() is not invoked");
+	validate_and_next(__func__, shared_destroy_ret, LOCATIONS_ERROR_NONE, "location_manager_destroy() is failed in the callback");
+
+	/* The next shared manager opens a new session */
+	ret = location_manager_create_shared(LOCATIONS_METHOD_GPS, &manager_02);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_create_shared() is failed");
+	ret = location_manager_destroy(manager_02);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static int cycle_updates = 0;
+static int cycle_duplicates = 0;
+static time_t cycle_timestamp = 0;
+
+/* A handler connected twice delivers each update twice, with the same timestamp */
+static void __cycle_position_updated_cb(double latitude, double longitude, double altitude, time_t timestamp, void *user_data)
+{
+	if (cycle_updates > 0 && timestamp == cycle_timestamp)
+		cycle_duplicates++;
+	else
+		cycle_updates++;
+	cycle_timestamp = timestamp;
+}
+
+static void utc_location_location_manager_start_stop_cycle_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	int i, timeout;
+	location_manager_h manager_02;
+
+	ret = location_manager_create(LOCATIONS_METHOD_GPS, &manager_02);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_create() is failed");
+
+	ret = location_manager_set_position_updated_cb(manager_02, __cycle_position_updated_cb, 1, NULL);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_set_position_updated_cb() is failed");
+
+	/* Starting twice and stopping twice are no-ops, cycling must not pile up signal handlers */
+	for (i = 0; i < 2000 && ret == LOCATIONS_ERROR_NONE; i++) {
+		ret = location_manager_start(manager_02);
+		if (ret == LOCATIONS_ERROR_NONE)
+			ret = location_manager_start(manager_02);
+		if (ret == LOCATIONS_ERROR_NONE)
+			ret = location_manager_stop(manager_02);
+		if (ret == LOCATIONS_ERROR_NONE)
+			ret = location_manager_stop(manager_02);
+	}
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_start() or location_manager_stop() is failed");
+
+	cycle_updates = 0;
+	cycle_duplicates = 0;
+	ret = location_manager_start(manager_02);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_start() is failed");
+
+	/* Each update must come once, wait for a few of them */
+	for (timeout = 0; timeout < 60 && cycle_updates < 3; timeout++)
+		sleep(1);
+
+	location_manager_stop(manager_02);
+	location_manager_unset_position_updated_cb(manager_02);
+	location_manager_destroy(manager_02);
+
+	dts_message(__func__, "%d updates and %d duplicates after %d cycles", cycle_updates, cycle_duplicates, i);
+	validate_and_next(__func__, cycle_updates >= 3, true, "no position update");
+	validate_eq(__func__, cycle_duplicates, 0);
+}
+
 static void utc_location_location_manager_add_boundary_p(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
@@ -699,6 +982,63 @@ static void utc_location_location_manager_remove_boundary_n_04(void)
 	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
 }
 
+static void utc_location_location_manager_add_boundaries_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_coords_s center = {37.258, 127.056};
+	location_bounds_h bounds_list[2];
+
+	location_bounds_create_circle(center, 30, &bounds_list[0]);
+	location_bounds_create_circle(center, 60, &bounds_list[1]);
+	ret = location_manager_add_boundaries(manager, bounds_list, 2);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_add_boundaries() is failed");
+
+	ret = location_manager_remove_boundaries(manager, bounds_list, 2);
+	location_bounds_destroy(bounds_list[0]);
+	location_bounds_destroy(bounds_list[1]);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_add_boundaries_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_bounds_h bounds_list[2] = {NULL, NULL};
+
+	ret = location_manager_add_boundaries(manager, bounds_list, 2);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_remove_boundaries_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_remove_boundaries(manager, NULL, 1);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_replace_boundaries_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_coords_s center = {37.258, 127.056};
+	location_bounds_h bounds;
+
+	location_bounds_create_circle(center, 30, &bounds);
+	ret = location_manager_replace_boundaries(manager, &bounds, 1);
+	location_bounds_destroy(bounds);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_replace_boundaries() is failed");
+
+	ret = location_manager_replace_boundaries(manager, NULL, 0);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_replace_boundaries_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_replace_boundaries(manager, NULL, 1);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
 static void utc_location_location_manager_get_method_p(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
@@ -1329,155 +1669,848 @@ static void utc_location_location_bounds_contains_coordinates_n_02(void)
 	validate_eq(__func__, ret, FALSE);
 }
 
-static void utc_location_location_manager_get_last_accuracy_p(void)
+static void utc_location_location_bounds_contains_coordinates_batch_p(void)
 {
-
 	int ret = LOCATIONS_ERROR_NONE;
 
-	double horizontal, vertical;
-	location_accuracy_level_e level;
+	//Add the polygon bounds
+	int poly_size = 3;
+	location_coords_s coord_list[poly_size];
 
-	ret = location_manager_get_last_accuracy(manager, &level, &horizontal, &vertical);
-	dts_message(__func__, "Level : %d, horizontal: %g, vertical : %g\n", level, horizontal, vertical);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+	coord_list[0].latitude = 10;
+	coord_list[0].longitude = 10;
+	coord_list[1].latitude = 20;
+	coord_list[1].longitude = 20;
+	coord_list[2].latitude = 30;
+	coord_list[2].longitude = 10;
+
+	location_bounds_h bounds_poly;
+	ret = location_bounds_create_polygon(coord_list, poly_size, &bounds_poly);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_create_polygon() is failed");
+
+	location_coords_s test_coords[3];
+	test_coords[0].latitude = 20;
+	test_coords[0].longitude = 12;
+	test_coords[1].latitude = 50;
+	test_coords[1].longitude = 50;
+	test_coords[2].latitude = -91;
+	test_coords[2].longitude = 181;
+	bool contained[3];
+	ret = location_bounds_contains_coordinates_batch(bounds_poly, test_coords, 3, contained);
+
+	location_bounds_destroy(bounds_poly);
+
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_contains_coordinates_batch() is failed");
+	validate_eq(__func__, contained[0] == TRUE && contained[1] == FALSE && contained[2] == FALSE, TRUE);
 }
 
-static void utc_location_location_manager_get_last_accuracy_n(void)
+static void utc_location_location_bounds_contains_coordinates_batch_n(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
 
-	double horizontal, vertical;
-	location_accuracy_level_e level;
+	location_coords_s test_coords;
+	test_coords.latitude = 12;
+	test_coords.longitude = 12;
+	bool contained;
+	ret = location_bounds_contains_coordinates_batch(NULL, &test_coords, 1, &contained);
 
-	ret = location_manager_get_last_accuracy(NULL, &level, &horizontal, &vertical);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+	validate_eq(__func__, ret, LOCATION_BOUNDS_ERROR_INVALID_PARAMETER);
 }
 
-static void utc_location_location_manager_get_last_accuracy_n_02(void)
+static void utc_location_location_bounds_get_bounding_box_p(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
 
-	double horizontal, vertical;
+	//Add the polygon bounds
+	int poly_size = 3;
+	location_coords_s coord_list[poly_size];
 
-	ret = location_manager_get_last_accuracy(manager, NULL, &horizontal, &vertical);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+	coord_list[0].latitude = 10;
+	coord_list[0].longitude = 10;
+	coord_list[1].latitude = 20;
+	coord_list[1].longitude = 20;
+	coord_list[2].latitude = 30;
+	coord_list[2].longitude = 10;
+
+	location_bounds_h bounds_poly;
+	ret = location_bounds_create_polygon(coord_list, poly_size, &bounds_poly);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_create_polygon() is failed");
+
+	location_coords_s top_left;
+	location_coords_s bottom_right;
+	ret = location_bounds_get_bounding_box(bounds_poly, &top_left, &bottom_right);
+
+	location_bounds_destroy(bounds_poly);
+
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_get_bounding_box() is failed");
+	validate_eq(__func__, top_left.latitude == 30 && top_left.longitude == 10 && bottom_right.latitude == 10
+		    && bottom_right.longitude == 20, TRUE);
 }
 
-static void utc_location_location_manager_get_last_accuracy_n_03(void)
+static void utc_location_location_bounds_get_bounding_box_n(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
 
-	double vertical;
-	location_accuracy_level_e level;
+	location_coords_s top_left;
+	location_coords_s bottom_right;
+	ret = location_bounds_get_bounding_box(NULL, &top_left, &bottom_right);
 
-	ret = location_manager_get_last_accuracy(manager, &level, NULL, &vertical);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+	validate_eq(__func__, ret, LOCATION_BOUNDS_ERROR_INVALID_PARAMETER);
 }
 
-static void utc_location_location_manager_get_last_accuracy_n_04(void)
+static void utc_location_location_bounds_prepare_p(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
 
-	double horizontal;
-	location_accuracy_level_e level;
+	int poly_size = 3;
+	location_coords_s coord_list[poly_size];
 
-	ret = location_manager_get_last_accuracy(manager, &level, &horizontal, NULL);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
-}
+	coord_list[0].latitude = 10;
+	coord_list[0].longitude = 10;
+	coord_list[1].latitude = 20;
+	coord_list[1].longitude = 20;
+	coord_list[2].latitude = 30;
+	coord_list[2].longitude = 10;
 
-static void utc_location_location_manager_get_last_position_p(void)
-{
+	location_bounds_h bounds_poly;
+	ret = location_bounds_create_polygon(coord_list, poly_size, &bounds_poly);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_create_polygon() is failed");
 
-	int ret = LOCATIONS_ERROR_NONE;
+	ret = location_bounds_prepare(bounds_poly, 16);
 
-	double altitude;
-	double latitude;
-	double longitude;
-	time_t timestamp;
+	location_coords_s inside = {20, 12};
+	location_coords_s outside = {20, 21};
+	bool is_inside = location_bounds_contains_coordinates(bounds_poly, inside);
+	bool is_outside = !location_bounds_contains_coordinates(bounds_poly, outside);
 
-	ret = location_manager_get_last_position(manager, &altitude, &latitude, &longitude, &timestamp);
-	dts_message(__func__, "altitude : %lf, latitude : %lf, longitude : %lf, timestamp:%d", latitude, latitude, longitude,
-		    timestamp);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+	location_bounds_destroy(bounds_poly);
+
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_prepare() is failed");
+	validate_eq(__func__, is_inside && is_outside, TRUE);
 }
 
-static void utc_location_location_manager_get_last_position_n(void)
+static void utc_location_location_bounds_prepare_n(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
 
-	double altitude;
-	double latitude;
-	double longitude;
-	time_t timestamp;
+	ret = location_bounds_prepare(NULL, 16);
 
-	ret = location_manager_get_last_position(NULL, &altitude, &latitude, &longitude, &timestamp);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+	validate_eq(__func__, ret, LOCATION_BOUNDS_ERROR_INVALID_PARAMETER);
 }
 
-static void utc_location_location_manager_get_last_position_n_02(void)
+static void utc_location_location_bounds_prepare_n_02(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
 
-	double latitude;
-	double longitude;
-	time_t timestamp;
+	location_coords_s center;
+	center.latitude = 37.258;
+	center.longitude = 127.056;
 
-	ret = location_manager_get_last_position(manager, NULL, &latitude, &longitude, &timestamp);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
-}
+	location_bounds_h bounds_circle;
+	ret = location_bounds_create_circle(center, 1000, &bounds_circle);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_create_circle() is failed");
 
-static void utc_location_location_manager_get_last_position_n_03(void)
-{
-	int ret = LOCATIONS_ERROR_NONE;
+	ret = location_bounds_prepare(bounds_circle, 16);
 
-	double altitude;
-	double longitude;
-	time_t timestamp;
+	location_bounds_destroy(bounds_circle);
 
-	ret = location_manager_get_last_position(manager, &altitude, NULL, &longitude, &timestamp);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+	validate_eq(__func__, ret, LOCATION_BOUNDS_ERROR_INCORRECT_TYPE);
 }
 
-static void utc_location_location_manager_get_last_position_n_04(void)
+static bool capi_bounds_set_cb(location_bounds_h bounds, void *user_data)
 {
-	int ret = LOCATIONS_ERROR_NONE;
-
-	double altitude;
-	double latitude;
-	time_t timestamp;
-
-	ret = location_manager_get_last_position(manager, &altitude, &latitude, NULL, &timestamp);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+	int *count = (int *)user_data;
+	(*count)++;
+	return TRUE;
 }
 
-static void utc_location_location_manager_get_last_position_n_05(void)
+static void utc_location_location_bounds_set_foreach_containing_bounds_p(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
 
-	double altitude;
-	double latitude;
-	double longitude;
+	location_coords_s center;
+	center.latitude = 37.258;
+	center.longitude = 127.056;
 
-	ret = location_manager_get_last_position(manager, &altitude, &latitude, &longitude, NULL);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+	location_bounds_h bounds_list[2];
+	ret = location_bounds_create_circle(center, 1000, &bounds_list[0]);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_create_circle() is failed");
+
+	center.latitude = 10;
+	center.longitude = 10;
+	ret = location_bounds_create_circle(center, 1000, &bounds_list[1]);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_create_circle() is failed");
+
+	location_bounds_set_h set;
+	ret = location_bounds_set_create_from_list(bounds_list, 2, &set);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_set_create_from_list() is failed");
+
+	int count = 0;
+	location_coords_s test_coords;
+	test_coords.latitude = 37.259;
+	test_coords.longitude = 127.056;
+	ret = location_bounds_set_foreach_containing_bounds(set, test_coords, capi_bounds_set_cb, &count);
+
+	location_bounds_set_destroy(set);
+	location_bounds_destroy(bounds_list[0]);
+	location_bounds_destroy(bounds_list[1]);
+
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_set_foreach_containing_bounds() is failed");
+	validate_eq(__func__, count, 1);
 }
 
-static void utc_location_location_manager_get_last_velocity_p(void)
+static void utc_location_location_bounds_set_foreach_containing_bounds_n(void)
 {
-
 	int ret = LOCATIONS_ERROR_NONE;
 
-	int climb;
-	int direction;
-	int speed;
-	time_t timestamp;
+	location_coords_s test_coords;
+	test_coords.latitude = 37.259;
+	test_coords.longitude = 127.056;
+	ret = location_bounds_set_foreach_containing_bounds(NULL, test_coords, capi_bounds_set_cb, NULL);
 
-	ret = location_manager_get_last_velocity(manager, &climb, &direction, &speed, &timestamp);
-	dts_message(__func__, "climb : %lf, direction : %lf, speed : %lf, timestamp:%d", climb, direction, speed, timestamp);
-	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+	validate_eq(__func__, ret, LOCATION_BOUNDS_ERROR_INVALID_PARAMETER);
 }
 
-static void utc_location_location_manager_get_last_velocity_n(void)
+static void utc_location_location_bounds_set_remove_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_coords_s center;
+	center.latitude = 37.258;
+	center.longitude = 127.056;
+
+	location_bounds_h bounds_circle;
+	ret = location_bounds_create_circle(center, 1000, &bounds_circle);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_create_circle() is failed");
+
+	location_bounds_set_h set;
+	ret = location_bounds_set_create(&set);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_set_create() is failed");
+
+	ret = location_bounds_set_add(set, bounds_circle);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_set_add() is failed");
+
+	int count = -1;
+	ret = location_bounds_set_remove(set, bounds_circle);
+	location_bounds_set_get_count(set, &count);
+
+	location_bounds_set_destroy(set);
+	location_bounds_destroy(bounds_circle);
+
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_set_remove() is failed");
+	validate_eq(__func__, count, 0);
+}
+
+static void utc_location_location_bounds_set_remove_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_coords_s center;
+	center.latitude = 37.258;
+	center.longitude = 127.056;
+
+	location_bounds_h bounds_circle;
+	ret = location_bounds_create_circle(center, 1000, &bounds_circle);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_create_circle() is failed");
+
+	location_bounds_set_h set;
+	ret = location_bounds_set_create(&set);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_bounds_set_create() is failed");
+
+	ret = location_bounds_set_remove(set, bounds_circle);
+
+	location_bounds_set_destroy(set);
+	location_bounds_destroy(bounds_circle);
+
+	validate_eq(__func__, ret, LOCATION_BOUNDS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_accuracy_p(void)
+{
+
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double horizontal, vertical;
+	location_accuracy_level_e level;
+
+	ret = location_manager_get_last_accuracy(manager, &level, &horizontal, &vertical);
+	dts_message(__func__, "Level : %d, horizontal: %g, vertical : %g\n", level, horizontal, vertical);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_get_last_accuracy_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double horizontal, vertical;
+	location_accuracy_level_e level;
+
+	ret = location_manager_get_last_accuracy(NULL, &level, &horizontal, &vertical);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_accuracy_n_02(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double horizontal, vertical;
+
+	ret = location_manager_get_last_accuracy(manager, NULL, &horizontal, &vertical);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_accuracy_n_03(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double vertical;
+	location_accuracy_level_e level;
+
+	ret = location_manager_get_last_accuracy(manager, &level, NULL, &vertical);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_accuracy_n_04(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double horizontal;
+	location_accuracy_level_e level;
+
+	ret = location_manager_get_last_accuracy(manager, &level, &horizontal, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_fix_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_fix_s fix;
+	ret = location_manager_get_fix(manager, &fix);
+	dts_message(__func__, "Status : %d, latitude : %g, longitude : %g, speed : %g, satellites used : %d\n", fix.status, fix.latitude,
+		    fix.longitude, fix.speed, fix.num_of_sat_used);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_get_fix_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_get_fix(manager, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_fix_n_02(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_fix_s fix;
+	ret = location_manager_get_fix(NULL, &fix);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_predict_position_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	double altitude, latitude, longitude;
+
+	/* The prediction needs a fix */
+	wait_for_service(__func__);
+	wait_for_position(__func__);
+
+	ret = location_manager_predict_position(manager, 0.1, &altitude, &latitude, &longitude);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_predict_position_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	double altitude, latitude, longitude;
+
+	ret = location_manager_predict_position(manager, 0.1, &altitude, NULL, &longitude);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_predict_position_n_02(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	double altitude, latitude, longitude;
+
+	ret = location_manager_predict_position(manager, 3601, &altitude, &latitude, &longitude);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void capi_position_updated_ns_cb(double latitude, double longitude, double altitude, const location_timestamp_s *time, void *user_data)
+{
+}
+
+static void utc_location_location_manager_set_position_updated_ns_cb_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_position_updated_ns_cb(manager, capi_position_updated_ns_cb, 1, NULL);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_set_position_updated_ns_cb() is failed");
+
+	ret = location_manager_unset_position_updated_ns_cb(manager);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_set_position_updated_ns_cb_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_position_updated_ns_cb(manager, capi_position_updated_ns_cb, 0, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_position_time_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_timestamp_s time;
+
+	/* There is no time before the first position */
+	wait_for_service(__func__);
+	wait_for_position(__func__);
+
+	ret = location_manager_get_last_position_time(manager, &time);
+	dts_message(__func__, "timestamp : %ld, monotonic : %lld ns\n", (long) time.timestamp, time.monotonic_ns);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_get_last_position_time_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_get_last_position_time(manager, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_velocity_time_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_timestamp_s time;
+
+	ret = location_manager_get_last_velocity_time(NULL, &time);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_set_dispatch_thread_enabled_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_dispatch_thread_enabled(manager, true, 64, LOCATIONS_DISPATCH_OVERFLOW_COALESCE);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_set_dispatch_thread_enabled() is failed");
+
+	ret = location_manager_set_dispatch_thread_enabled(manager, false, 0, LOCATIONS_DISPATCH_OVERFLOW_DROP_OLDEST);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_set_dispatch_thread_enabled_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_dispatch_thread_enabled(manager, true, LOCATION_MANAGER_DISPATCH_QUEUE_MAX + 1,
+							   LOCATIONS_DISPATCH_OVERFLOW_DROP_OLDEST);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_dispatch_dropped_count_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	unsigned int dropped, coalesced;
+
+	ret = location_manager_get_dispatch_dropped_count(manager, &dropped, &coalesced);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_get_dispatch_dropped_count_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	unsigned int dropped;
+
+	ret = location_manager_get_dispatch_dropped_count(manager, &dropped, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_set_duty_cycle_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	int interval;
+
+	ret = location_manager_set_duty_cycle(manager, LOCATIONS_DUTY_CYCLE_BALANCED, 1, 60);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_set_duty_cycle() is failed");
+
+	ret = location_manager_get_duty_cycle_interval(manager, &interval);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_get_duty_cycle_interval() is failed");
+	dts_message(__func__, "interval : %d\n", interval);
+
+	ret = location_manager_unset_duty_cycle(manager);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_set_duty_cycle_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_duty_cycle(manager, LOCATIONS_DUTY_CYCLE_BALANCED, 60, 1);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_duty_cycle_interval_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	int interval;
+
+	ret = location_manager_get_duty_cycle_interval(manager, &interval);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void capi_position_updated_cb(double latitude, double longitude, double altitude, time_t timestamp, void *user_data)
+{
+}
+
+static void utc_location_location_manager_add_position_updated_listener_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	int first, second;
+
+	ret = location_manager_add_position_updated_listener(manager, capi_position_updated_cb, NULL, &first);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_add_position_updated_listener() is failed");
+
+	ret = location_manager_add_position_updated_listener(manager, capi_position_updated_cb, NULL, &second);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_add_position_updated_listener() is failed");
+
+	location_manager_remove_listener(manager, first);
+	ret = location_manager_remove_listener(manager, second);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_add_position_updated_listener_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_add_position_updated_listener(manager, capi_position_updated_cb, NULL, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_remove_listener_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	int listener_id;
+
+	location_manager_add_position_updated_listener(manager, capi_position_updated_cb, NULL, &listener_id);
+	location_manager_remove_listener(manager, listener_id);
+	ret = location_manager_remove_listener(manager, listener_id);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_set_fix_cache_enabled_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_fix_cache_enabled(manager, true);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_set_fix_cache_enabled() is failed");
+
+	double altitude, latitude, longitude;
+	time_t timestamp;
+	ret = location_manager_get_position(manager, &altitude, &latitude, &longitude, &timestamp);
+	location_manager_set_fix_cache_enabled(manager, false);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_set_fix_cache_enabled_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_fix_cache_enabled(NULL, true);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void capi_smoothed_updated_cb(const location_fix_s *fix, void *user_data)
+{
+}
+
+static void utc_location_location_manager_set_smoothing_enabled_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_smoothing_enabled(manager, true, 1.0);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_set_smoothing_enabled() is failed");
+
+	ret = location_manager_set_smoothed_updated_cb(manager, capi_smoothed_updated_cb, 1, NULL);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_set_smoothed_updated_cb() is failed");
+
+	location_manager_unset_smoothed_updated_cb(manager);
+	ret = location_manager_set_smoothing_enabled(manager, false, 0);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_set_smoothing_enabled_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_smoothing_enabled(manager, true, 0);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_smoothed_fix_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_get_smoothed_fix(manager, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_smoothed_fix_n_02(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_fix_s fix;
+
+	location_manager_set_smoothing_enabled(manager, false, 0);
+	ret = location_manager_get_smoothed_fix(manager, &fix);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE);
+}
+
+static void utc_location_location_manager_set_position_distance_filter_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_position_distance_filter(manager, 50);
+	location_manager_set_position_distance_filter(manager, 0);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_set_position_distance_filter_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_position_distance_filter(manager, -1);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void capi_geofence_event_cb(location_bounds_h bounds, location_geofence_event_e event, const location_fix_s *fix, void *user_data)
+{
+}
+
+static void utc_location_location_manager_add_geofence_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_coords_s center = {37.258, 127.056};
+	location_bounds_h bounds;
+
+	location_bounds_create_circle(center, 100, &bounds);
+	ret = location_manager_add_geofence(manager, bounds);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_add_geofence() is failed");
+
+	ret = location_manager_remove_geofence(manager, bounds);
+	location_bounds_destroy(bounds);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_add_geofence_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_add_geofence(manager, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_remove_geofence_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+	location_coords_s center = {37.258, 127.056};
+	location_bounds_h bounds;
+
+	location_bounds_create_circle(center, 100, &bounds);
+	ret = location_manager_remove_geofence(manager, bounds);
+	location_bounds_destroy(bounds);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_set_geofence_event_cb_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_geofence_event_cb(manager, capi_geofence_event_cb, 20, 60, NULL);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_set_geofence_event_cb() is failed");
+
+	ret = location_manager_unset_geofence_event_cb(manager);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_set_geofence_event_cb_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_geofence_event_cb(manager, capi_geofence_event_cb, -1, 60, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void capi_batch_updated_cb(const location_fix_s *fixes, int count, void *user_data)
+{
+}
+
+static void utc_location_location_manager_set_batch_updated_cb_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_batch_updated_cb(manager, capi_batch_updated_cb, 1, 10, 60, NULL);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_set_batch_updated_cb() is failed");
+
+	ret = location_manager_unset_batch_updated_cb(manager);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_set_batch_updated_cb_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_batch_updated_cb(manager, capi_batch_updated_cb, 1, LOCATION_MANAGER_BATCH_CAPACITY + 1, 60, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_set_batch_updated_cb_n_02(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	ret = location_manager_set_batch_updated_cb(manager, NULL, 1, 10, 60, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_history_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_fix_s fixes[LOCATION_MANAGER_HISTORY_CAPACITY];
+	int count = -1;
+	ret = location_manager_get_history(manager, fixes, LOCATION_MANAGER_HISTORY_CAPACITY, &count);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_get_history() is failed");
+	validate_eq(__func__, count >= 0 && count <= LOCATION_MANAGER_HISTORY_CAPACITY, TRUE);
+}
+
+static void utc_location_location_manager_get_history_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	int count;
+	ret = location_manager_get_history(manager, NULL, LOCATION_MANAGER_HISTORY_CAPACITY, &count);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_history_since_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_fix_s fixes[LOCATION_MANAGER_HISTORY_CAPACITY];
+	int count = -1;
+	ret = location_manager_get_history_since(manager, time(NULL), fixes, LOCATION_MANAGER_HISTORY_CAPACITY, &count);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_get_history_since() is failed");
+	validate_eq(__func__, count, 0);
+}
+
+static void utc_location_location_manager_get_history_since_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_fix_s fixes[1];
+	int count;
+	ret = location_manager_get_history_since(NULL, 0, fixes, 1, &count);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_position_p(void)
+{
+
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double altitude;
+	double latitude;
+	double longitude;
+	time_t timestamp;
+
+	ret = location_manager_get_last_position(manager, &altitude, &latitude, &longitude, &timestamp);
+	dts_message(__func__, "altitude : %lf, latitude : %lf, longitude : %lf, timestamp:%d", latitude, latitude, longitude,
+		    timestamp);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_get_last_position_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double altitude;
+	double latitude;
+	double longitude;
+	time_t timestamp;
+
+	ret = location_manager_get_last_position(NULL, &altitude, &latitude, &longitude, &timestamp);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_position_n_02(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double latitude;
+	double longitude;
+	time_t timestamp;
+
+	ret = location_manager_get_last_position(manager, NULL, &latitude, &longitude, &timestamp);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_position_n_03(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double altitude;
+	double longitude;
+	time_t timestamp;
+
+	ret = location_manager_get_last_position(manager, &altitude, NULL, &longitude, &timestamp);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_position_n_04(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double altitude;
+	double latitude;
+	time_t timestamp;
+
+	ret = location_manager_get_last_position(manager, &altitude, &latitude, NULL, &timestamp);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_position_n_05(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	double altitude;
+	double latitude;
+	double longitude;
+
+	ret = location_manager_get_last_position(manager, &altitude, &latitude, &longitude, NULL);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_last_velocity_p(void)
+{
+
+	int ret = LOCATIONS_ERROR_NONE;
+
+	int climb;
+	int direction;
+	int speed;
+	time_t timestamp;
+
+	ret = location_manager_get_last_velocity(manager, &climb, &direction, &speed, &timestamp);
+	dts_message(__func__, "climb : %lf, direction : %lf, speed : %lf, timestamp:%d", climb, direction, speed, timestamp);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_NONE);
+}
+
+static void utc_location_location_manager_get_last_velocity_n(void)
 {
 	int ret = LOCATIONS_ERROR_NONE;
 
@@ -1580,6 +2613,56 @@ static void utc_location_location_manager_is_supported_method_n_02(void)
 	validate_eq(__func__, supported, FALSE);
 }
 
+static void utc_location_location_manager_get_distances_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_coords_s from[2] = { {37.258, 127.056}, {0, 0} };
+	location_coords_s to[2] = { {37.258, 127.056}, {0, 1} };
+	double out[2];
+
+	ret = location_manager_get_distances(from, to, 2, out);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_get_distances() is failed");
+	/* One degree of the equator is about 111 km */
+	validate_eq(__func__, out[0] == 0 && out[1] > 111000 && out[1] < 111400, TRUE);
+}
+
+static void utc_location_location_manager_get_distances_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_coords_s from[1] = { {91, 0} };
+	location_coords_s to[1] = { {0, 0} };
+	double out[1];
+
+	ret = location_manager_get_distances(from, to, 1, out);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
+static void utc_location_location_manager_get_distances_from_p(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_coords_s from = {0, 0};
+	location_coords_s to[2] = { {0, 0}, {1, 0} };
+	double out[2];
+
+	ret = location_manager_get_distances_from(from, to, 2, out);
+	validate_and_next(__func__, ret, LOCATIONS_ERROR_NONE, "location_manager_get_distances_from() is failed");
+	validate_eq(__func__, out[0] == 0 && out[1] > 111000 && out[1] < 111400, TRUE);
+}
+
+static void utc_location_location_manager_get_distances_from_n(void)
+{
+	int ret = LOCATIONS_ERROR_NONE;
+
+	location_coords_s from = {0, 0};
+	double out[1];
+
+	ret = location_manager_get_distances_from(from, NULL, 1, out);
+	validate_eq(__func__, ret, LOCATIONS_ERROR_INVALID_PARAMETER);
+}
+
 static void utc_location_location_manager_send_command_p(void)
 {
 
@@ -136,6 +136,23 @@ int location_bounds_create_polygon(location_coords_s* coords_list, int length, l
  */
 bool location_bounds_contains_coordinates(location_bounds_h bounds, location_coords_s coords);
 
+/**
+ * @brief Check if the bounds contains each of the specified coordinates.
+ * @details This is equivalent to calling location_bounds_contains_coordinates() for every element of @a coords_list,
+ * but does not allocate any memory per coordinate.
+ * @remarks @a contained_list must be able to hold @a length elements. Coordinates out of range are reported as not contained.
+ * @param[in]   bounds  The location bounds handle
+ * @param[in]   coords_list   The list of coordinates
+ * @param[in]   length  The length of the coordinates list
+ * @param[out]   contained_list  The results indicating whether the boundary contains each coordinate (@c true = contained, @c false = not contained )
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATION_BOUNDS_ERROR_NONE Successful
+ * @retval #LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #LOCATION_BOUNDS_ERROR_INVALID_PARAMETER	Invalid parameter
+ * @see location_bounds_contains_coordinates()
+ */
+int location_bounds_contains_coordinates_batch(location_bounds_h bounds, const location_coords_s *coords_list, int length, bool *contained_list);
+
 /**
  * @brief Get the type of location bounds.
  * @param[in] bounds  The location bounds handle
@@ -149,6 +166,21 @@ bool location_bounds_contains_coordinates(location_bounds_h bounds, location_coo
  */
 int location_bounds_get_type(location_bounds_h bounds, location_bounds_type_e *type);
 
+/**
+ * @brief Get the bounding box of location bounds.
+ * @details The bounding box is computed once when the bounds is created and is used to reject coordinates quickly
+ * in location_bounds_contains_coordinates(). For a circle it is slightly larger than the circle itself.
+ * @remarks If the bounds crosses the 180th meridian or reaches a pole, the longitude range is [-180 ~ 180].
+ * @param[in] bounds  The location bounds handle
+ * @param[out] top_left  The top left position of the bounding box
+ * @param[out] bottom_right  The bottom right position of the bounding box
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATION_BOUNDS_ERROR_NONE Successful
+ * @retval #LOCATION_BOUNDS_ERROR_INVALID_PARAMETER	Invalid parameter
+ * @see location_bounds_contains_coordinates()
+ */
+int location_bounds_get_bounding_box(location_bounds_h bounds, location_coords_s *top_left, location_coords_s *bottom_right);
+
 /**
  * @brief Get the center position and radius of circle bounds.
  * @param[in] bounds  The location bounds handle
@@ -190,6 +222,27 @@ int location_bounds_get_circle_coords(location_bounds_h bounds, location_coords_
  */
 int location_bounds_foreach_polygon_coords(location_bounds_h bounds, polygon_coords_cb callback, void *user_data);
 
+/**
+ * @brief Prepares polygon bounds for repeated containment checks.
+ * @details A uniform grid of @a grid_resolution x @a grid_resolution cells is laid over the bounding box of the polygon.
+ * Each cell remembers the polygon edges crossing it, so that location_bounds_contains_coordinates() only tests those edges,
+ * and cells without any edge are answered by a single lookup.
+ * Preparing takes time and memory proportional to the number of vertices and cells, and pays off when the same bounds is checked many times.
+ * Preparing bounds which is already prepared rebuilds the grid with the new resolution.
+ * The results are the same as without the grid, including for coordinates on an edge or a vertex of the polygon.
+ * @remarks The grid is released with location_bounds_destroy().
+ * @param[in] bounds  The location bounds handle of polygon type
+ * @param[in] grid_resolution  The number of cells along each side of the grid, from 1 to 1024
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATION_BOUNDS_ERROR_NONE Successful
+ * @retval #LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY	Out of memory
+ * @retval #LOCATION_BOUNDS_ERROR_INVALID_PARAMETER	Invalid parameter
+ * @retval #LOCATION_BOUNDS_ERROR_INCORRECT_TYPE Incorrect bounds type
+ * @see location_bounds_create_polygon()
+ * @see location_bounds_contains_coordinates()
+ */
+int location_bounds_prepare(location_bounds_h bounds, int grid_resolution);
+
 /**
  * @brief Releases the location bounds.
  * @param[in] bounds The location bounds handle
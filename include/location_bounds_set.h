@@ -0,0 +1,149 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License. 
+*/
+
+#ifndef __TIZEN_LOCATION_BOUNDS_SET_H__
+#define __TIZEN_LOCATION_BOUNDS_SET_H__
+
+#include <tizen_type.h>
+#include <tizen_error.h>
+#include <location_bounds.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup CAPI_LOCATION_BOUNDS_MODULE
+ * @{
+ */
+
+/**
+ * @brief The location bounds set handle.
+ * @details A bounds set indexes many location bounds in an R-tree so that the bounds containing a coordinate
+ * are found without testing every bounds.
+ */
+ typedef void *location_bounds_set_h;
+
+/**
+ * @brief Gets called iteratively to notify you of the bounds containing a coordinate.
+ * @param[in] bounds  The location bounds handle
+ * @param[in] user_data	The user data passed from the foreach function
+ * @return @c true to continue with the next iteration of the loop, \n @c false to break out of the loop
+ * @pre location_bounds_set_foreach_containing_bounds() will invoke this callback.
+ * @see location_bounds_set_foreach_containing_bounds()
+ */
+typedef bool (*location_bounds_set_cb)(location_bounds_h bounds, void *user_data);
+
+/**
+ * @brief Creates a new empty location bounds set.
+ * @remarks @a set must be released location_bounds_set_destroy() by you.
+ * @param[out] set  A location bounds set handle to be newly created on success
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATION_BOUNDS_ERROR_NONE Successful
+ * @retval #LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #LOCATION_BOUNDS_ERROR_INVALID_PARAMETER	Invalid parameter
+ * @see location_bounds_set_create_from_list()
+ * @see location_bounds_set_destroy()
+ */
+int location_bounds_set_create(location_bounds_set_h *set);
+
+/**
+ * @brief Creates a new location bounds set holding the given bounds.
+ * @details The index is bulk-loaded, which is faster and gives better query performance than adding the bounds one by one.
+ * Use it for static sets.
+ * @remarks @a set must be released location_bounds_set_destroy() by you.
+ * @remarks The set refers to the bounds without copying them, so they must not be destroyed while they are in the set.
+ * @param[in] bounds_list  The list of location bounds handles
+ * @param[in] length  The length of the bounds list
+ * @param[out] set  A location bounds set handle to be newly created on success
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATION_BOUNDS_ERROR_NONE Successful
+ * @retval #LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #LOCATION_BOUNDS_ERROR_INVALID_PARAMETER	Invalid parameter
+ * @see location_bounds_set_create()
+ * @see location_bounds_set_destroy()
+ */
+int location_bounds_set_create_from_list(const location_bounds_h *bounds_list, int length, location_bounds_set_h *set);
+
+/**
+ * @brief Adds a bounds to the location bounds set.
+ * @remarks The set refers to @a bounds without copying it, so it must not be destroyed while it is in the set.
+ * @param[in] set  The location bounds set handle
+ * @param[in] bounds  The location bounds handle
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATION_BOUNDS_ERROR_NONE Successful
+ * @retval #LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #LOCATION_BOUNDS_ERROR_INVALID_PARAMETER	Invalid parameter or @a bounds is already in the set
+ * @see location_bounds_set_remove()
+ */
+int location_bounds_set_add(location_bounds_set_h set, location_bounds_h bounds);
+
+/**
+ * @brief Removes a bounds from the location bounds set.
+ * @param[in] set  The location bounds set handle
+ * @param[in] bounds  The location bounds handle
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATION_BOUNDS_ERROR_NONE Successful
+ * @retval #LOCATION_BOUNDS_ERROR_INVALID_PARAMETER	Invalid parameter or @a bounds is not in the set
+ * @see location_bounds_set_add()
+ */
+int location_bounds_set_remove(location_bounds_set_h set, location_bounds_h bounds);
+
+/**
+ * @brief Gets the number of bounds in the location bounds set.
+ * @param[in] set  The location bounds set handle
+ * @param[out] count  The number of bounds
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATION_BOUNDS_ERROR_NONE Successful
+ * @retval #LOCATION_BOUNDS_ERROR_INVALID_PARAMETER	Invalid parameter
+ */
+int location_bounds_set_get_count(location_bounds_set_h set, int *count);
+
+/**
+ * @brief Retrieves all bounds of the set containing the specified coordinates.
+ * @param[in] set  The location bounds set handle
+ * @param[in] coords  The coordinates
+ * @param[in] callback	The iteration callback function
+ * @param[in] user_data The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATION_BOUNDS_ERROR_NONE Successful
+ * @retval #LOCATION_BOUNDS_ERROR_INVALID_PARAMETER	Invalid parameter
+ * @post It invokes location_bounds_set_cb() for each bounds containing @a coords.
+ * @see location_bounds_set_cb()
+ * @see location_bounds_contains_coordinates()
+ */
+int location_bounds_set_foreach_containing_bounds(location_bounds_set_h set, location_coords_s coords, location_bounds_set_cb callback, void *user_data);
+
+/**
+ * @brief Releases the location bounds set.
+ * @remarks The bounds in the set are not released.
+ * @param[in] set The location bounds set handle
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATION_BOUNDS_ERROR_NONE Successful
+ * @retval #LOCATION_BOUNDS_ERROR_INVALID_PARAMETER	Invalid parameter
+ * @see location_bounds_set_create()
+ * @see location_bounds_set_create_from_list()
+*/
+int location_bounds_set_destroy(location_bounds_set_h set);
+
+/**
+ * @}
+ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIZEN_LOCATION_BOUNDS_SET_H__ */
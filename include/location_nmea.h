@@ -0,0 +1,222 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef __TIZEN_LOCATION_NMEA_H__
+#define __TIZEN_LOCATION_NMEA_H__
+
+#include <tizen_type.h>
+#include <tizen_error.h>
+#include <locations.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup CAPI_LOCATION_GPS_STATUS_MODULE
+ * @{
+ */
+
+/**
+ * @brief The longest NMEA sentence, from the '$' to the checksum.
+ */
+#define LOCATION_NMEA_SENTENCE_MAX	82
+
+/**
+ * @brief The NMEA parser handle.
+ * @details A parser takes the NMEA data in chunks of any size and reports each complete sentence it knows
+ * as a record, without allocating memory.
+ */
+typedef void *location_nmea_parser_h;
+
+/**
+ * @brief Enumerations of the NMEA sentences reported by the parser.
+ */
+typedef enum
+{
+    LOCATIONS_NMEA_GGA,  /**< Fix data */
+    LOCATIONS_NMEA_RMC,  /**< Recommended minimum data */
+    LOCATIONS_NMEA_GSA,  /**< Dilution of precision and active satellites */
+    LOCATIONS_NMEA_GSV,  /**< Satellites in view */
+    LOCATIONS_NMEA_VTG   /**< Course and speed over ground */
+} location_nmea_sentence_e;
+
+/**
+ * @brief The GGA sentence. Empty fields are 0.
+ */
+typedef struct
+{
+	double utc_time;	/**< The time of the fix (seconds since midnight UTC) */
+	double latitude;	/**< The latitude (degrees, negative to the south) */
+	double longitude;	/**< The longitude (degrees, negative to the west) */
+	int quality;		/**< The fix quality, 0 when there is no fix */
+	int num_of_sat_used;	/**< The number of satellites used for the fix */
+	double hdop;		/**< The horizontal dilution of precision */
+	double altitude;	/**< The altitude above the mean sea level (meters) */
+	double geoid_separation;	/**< The height of the geoid above the ellipsoid (meters) */
+} location_nmea_gga_s;
+
+/**
+ * @brief The RMC sentence. Empty fields are 0.
+ */
+typedef struct
+{
+	double utc_time;	/**< The time of the fix (seconds since midnight UTC) */
+	bool is_valid;		/**< @c true if the receiver reports the data valid */
+	double latitude;	/**< The latitude (degrees, negative to the south) */
+	double longitude;	/**< The longitude (degrees, negative to the west) */
+	double speed;		/**< The speed over ground (km/h) */
+	double direction;	/**< The course over ground (degrees from the true north) */
+	int day;		/**< The day of the month [1 ~ 31] */
+	int month;		/**< The month [1 ~ 12] */
+	int year;		/**< The year, four digits */
+} location_nmea_rmc_s;
+
+/**
+ * @brief The GSA sentence. Empty fields are 0.
+ */
+typedef struct
+{
+	bool is_automatic;	/**< @c true if the receiver selects the fix type itself */
+	int fix_type;		/**< 1 without fix, 2 for a 2D fix, 3 for a 3D fix */
+	int prn[12];		/**< The satellites used for the fix */
+	int num_of_prn;		/**< The number of valid entries of @a prn */
+	double pdop;		/**< The position dilution of precision */
+	double hdop;		/**< The horizontal dilution of precision */
+	double vdop;		/**< The vertical dilution of precision */
+} location_nmea_gsa_s;
+
+/**
+ * @brief A satellite of a GSV sentence.
+ */
+typedef struct
+{
+	unsigned int prn;	/**< The PRN code */
+	unsigned int elevation;	/**< The elevation (degrees) */
+	unsigned int azimuth;	/**< The azimuth (degrees from the true north) */
+	int snr;		/**< The signal to noise ratio (dB), -1 when the satellite is not tracked */
+} location_nmea_satellite_s;
+
+/**
+ * @brief The GSV sentence, one of the messages listing the satellites in view.
+ */
+typedef struct
+{
+	int num_of_messages;	/**< The number of GSV messages of the cycle */
+	int message_number;	/**< The number of this message, from 1 */
+	int num_of_inview;	/**< The number of satellites in view */
+	location_nmea_satellite_s satellites[4];	/**< The satellites of this message */
+	int num_of_satellites;	/**< The number of valid entries of @a satellites */
+} location_nmea_gsv_s;
+
+/**
+ * @brief The VTG sentence. Empty fields are 0.
+ */
+typedef struct
+{
+	double direction;	/**< The course over ground (degrees from the true north) */
+	double magnetic_direction;	/**< The course over ground (degrees from the magnetic north) */
+	double speed;		/**< The speed over ground (km/h) */
+} location_nmea_vtg_s;
+
+/**
+ * @brief A sentence decoded by the NMEA parser.
+ */
+typedef struct
+{
+	location_nmea_sentence_e type;	/**< The sentence, which selects the member of @a data */
+	char talker[3];		/**< The talker identifier, such as "GP" or "GN" */
+	union {
+		location_nmea_gga_s gga;
+		location_nmea_rmc_s rmc;
+		location_nmea_gsa_s gsa;
+		location_nmea_gsv_s gsv;
+		location_nmea_vtg_s vtg;
+	} data;
+} location_nmea_record_s;
+
+/**
+ * @brief Called for each sentence decoded by the NMEA parser.
+ * @param[in] record  The decoded sentence, valid only in this callback
+ * @param[in] user_data  The user data passed from location_nmea_parser_create()
+ * @pre location_nmea_parser_feed() invokes this callback.
+ * @see location_nmea_parser_create()
+ */
+typedef void (*location_nmea_record_cb)(const location_nmea_record_s *record, void *user_data);
+
+/**
+ * @brief Creates a NMEA parser.
+ * @remarks @a parser must be released location_nmea_parser_destroy() by you.
+ * @param[in] callback  The callback invoked for each decoded sentence
+ * @param[in] user_data  The user data to be passed to the callback
+ * @param[out] parser  A NMEA parser handle to be newly created on success
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #LOCATIONS_ERROR_OUT_OF_MEMORY Out of memory
+ * @see location_nmea_parser_feed()
+ * @see location_nmea_parser_destroy()
+ */
+int location_nmea_parser_create(location_nmea_record_cb callback, void *user_data, location_nmea_parser_h *parser);
+
+/**
+ * @brief Releases a NMEA parser.
+ * @param[in] parser  The NMEA parser handle
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see location_nmea_parser_create()
+ */
+int location_nmea_parser_destroy(location_nmea_parser_h parser);
+
+/**
+ * @brief Feeds NMEA data to the parser.
+ * @details The data may be cut anywhere, a sentence split across calls is decoded once its end is fed.
+ * A sentence ends with its checksum, or with the end of the line if it has none. The sentences of
+ * gps_status_get_nmea() and gps_status_foreach_nmea_sentence() can be fed as they are. \n
+ * Sentences with a wrong checksum or longer than #LOCATION_NMEA_SENTENCE_MAX are counted and skipped,
+ * the other sentences than GGA, RMC, GSA, GSV and VTG are skipped.
+ * @param[in] parser  The NMEA parser handle
+ * @param[in] data  The NMEA data
+ * @param[in] length  The length of @a data in bytes
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @post It invokes location_nmea_record_cb() for each decoded sentence.
+ * @see location_nmea_parser_get_error_count()
+ */
+int location_nmea_parser_feed(location_nmea_parser_h parser, const char *data, int length);
+
+/**
+ * @brief Gets the number of sentences the parser skipped because they were corrupted.
+ * @param[in] parser  The NMEA parser handle
+ * @param[out] count  The number of sentences with a wrong checksum, cut by the start of another sentence or too long
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @see location_nmea_parser_feed()
+ */
+int location_nmea_parser_get_error_count(location_nmea_parser_h parser, unsigned int *count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIZEN_LOCATION_NMEA_H__ */
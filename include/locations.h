@@ -20,6 +20,7 @@
 #include <tizen_type.h>
 #include <tizen_error.h>
 #include <location_bounds.h>
+#include <location_bounds_set.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -90,6 +91,105 @@ typedef enum
     LOCATIONS_BOUNDARY_OUT  /**< Boundary Out (Zone Out) */
 } location_boundary_state_e;
 
+/**
+ * @brief Enumerations of the geofence events.
+ */
+typedef enum
+{
+    LOCATIONS_GEOFENCE_ENTER,  /**< The position entered the geofence */
+    LOCATIONS_GEOFENCE_EXIT,  /**< The position left the geofence */
+    LOCATIONS_GEOFENCE_DWELL  /**< The position stayed in the geofence for the dwell time */
+} location_geofence_event_e;
+
+/**
+ * @brief Enumerations of what the dispatch thread does when its queue is full.
+ * @see location_manager_set_dispatch_thread_enabled()
+ */
+typedef enum
+{
+    LOCATIONS_DISPATCH_OVERFLOW_DROP_OLDEST,  /**< The oldest queued event is dropped */
+    LOCATIONS_DISPATCH_OVERFLOW_COALESCE  /**< Only the latest event of each type is kept until the queue has room */
+} location_dispatch_overflow_e;
+
+/**
+ * @brief Enumerations of the duty cycle policies, the distance the device may travel between two fixes.
+ * @see location_manager_set_duty_cycle()
+ */
+typedef enum
+{
+    LOCATIONS_DUTY_CYCLE_HIGH_ACCURACY,  /**< About 10 meters between fixes */
+    LOCATIONS_DUTY_CYCLE_BALANCED,  /**< About 50 meters between fixes */
+    LOCATIONS_DUTY_CYCLE_POWER_SAVING  /**< About 200 meters between fixes */
+} location_duty_cycle_policy_e;
+
+/**
+ * @brief The number of fixes kept in the history of a location manager.
+ * @see location_manager_get_history()
+ */
+#define LOCATION_MANAGER_HISTORY_CAPACITY	128
+
+/**
+ * @brief The maximum number of fixes delivered at once to location_batch_updated_cb().
+ * @see location_manager_set_batch_updated_cb()
+ */
+#define LOCATION_MANAGER_BATCH_CAPACITY	128
+
+/**
+ * @brief The maximum queue size of the dispatch thread.
+ * @see location_manager_set_dispatch_thread_enabled()
+ */
+#define LOCATION_MANAGER_DISPATCH_QUEUE_MAX	1024
+
+/**
+ * @brief The longest interval of the duty cycle in seconds.
+ * @see location_manager_set_duty_cycle()
+ */
+#define LOCATION_MANAGER_DUTY_CYCLE_INTERVAL_MAX	3600
+
+/**
+ * @brief Enumerations of the fix status of a position.
+ */
+typedef enum
+{
+    LOCATIONS_FIX_NONE,	/**< No fix, the position is not valid */
+    LOCATIONS_FIX_2D,	/**< 2D fix, latitude and longitude are valid */
+    LOCATIONS_FIX_3D	/**< 3D fix, altitude is valid too */
+} location_fix_status_e;
+
+/**
+ * @brief Structure of the time of an update.
+ * @details @a timestamp is reported by the location service with a one second resolution.
+ * @a realtime_ns and @a monotonic_ns are taken when the update is received by the location manager.
+ * Use @a monotonic_ns to measure the time between updates, it does not jump when the system time is changed.
+ */
+typedef struct
+{
+	time_t timestamp;	/**< The timestamp (time when measurement took place or 0 if invalid) */
+	long long realtime_ns;	/**< The wall-clock reception time (nanoseconds since the Epoch, CLOCK_REALTIME) */
+	long long monotonic_ns;	/**< The monotonic reception time (nanoseconds, CLOCK_MONOTONIC) */
+} location_timestamp_s;
+
+/**
+ * @brief Structure of a location fix, the position with the velocity and accuracy known at that time.
+ */
+typedef struct
+{
+	location_fix_status_e status;	/**< The fix status of the position */
+	double latitude;	/**< The latitude [-90.0 ~ 90.0] (degrees) */
+	double longitude;	/**< The longitude [-180.0 ~ 180.0] (degrees) */
+	double altitude;	/**< The altitude (meters) */
+	double speed;	/**< The speed (km/h) */
+	double direction;	/**< The direction, degrees from the north */
+	double climb;	/**< The climb (km/h) */
+	location_accuracy_level_e level;	/**< The accuracy level */
+	double horizontal_accuracy;	/**< The horizontal accuracy (meters) */
+	double vertical_accuracy;	/**< The vertical accuracy (meters) */
+	int num_of_sat_used;	/**< The number of satellites used for the fix, 0 if unknown */
+	time_t timestamp;	/**< The timestamp of the position (time when measurement took place or 0 if invalid) */
+	long long realtime_ns;	/**< The wall-clock time the position was received (nanoseconds since the Epoch) */
+	long long monotonic_ns;	/**< The monotonic time the position was received (nanoseconds, CLOCK_MONOTONIC) */
+} location_fix_s;
+
 /**
  * @brief The location manager handle.
  */
@@ -118,6 +218,39 @@ typedef enum
  */
 typedef void(*location_position_updated_cb)(double latitude, double longitude, double altitude, time_t timestamp, void *user_data);
 
+/**
+ * @brief Called at defined interval with updated position information and the time it was received.
+ * @param[in] latitude  The updated latitude [-90.0 ~ 90.0] (degrees)
+ * @param[in] longitude The updated longitude [-180.0 ~ 180.0] (degrees)
+ * @param[in] altitude  The updated altitude (meters)
+ * @param[in] time  The time of the update, valid only in this callback
+ * @param[in] user_data  The user data passed from the call registration function
+ * @pre location_manager_start() will invoke this callback if you register this callback using location_manager_set_position_updated_ns_cb()
+ * @see location_manager_set_position_updated_ns_cb()
+ */
+typedef void(*location_position_updated_ns_cb)(double latitude, double longitude, double altitude, const location_timestamp_s *time, void *user_data);
+
+/**
+ * @brief Called with the smoothed fix after every position update while smoothing is enabled.
+ * @param[in] fix  The smoothed fix, valid only in this callback
+ * @param[in] user_data  The user data passed from the callback registration function
+ * @pre location_manager_start() will invoke this callback if you register this callback using location_manager_set_smoothed_updated_cb()
+ * @see location_manager_set_smoothing_enabled()
+ * @see location_manager_set_smoothed_updated_cb()
+ */
+typedef void(*location_smoothed_updated_cb)(const location_fix_s *fix, void *user_data);
+
+/**
+ * @brief Called with the position fixes accumulated since the previous batch.
+ * @param[in] fixes  The fixes, oldest first. They are valid only in this callback.
+ * @param[in] count  The number of fixes
+ * @param[in] user_data  The user data passed from the callback registration function
+ * @pre location_manager_start() will invoke this callback if you register this callback using location_manager_set_batch_updated_cb()
+ * @see location_manager_start()
+ * @see location_manager_set_batch_updated_cb()
+ */
+typedef void(*location_batch_updated_cb)(const location_fix_s *fixes, int count, void *user_data);
+
 /**
  * @brief Called at defined interval with updated velocity information.
  * @param[in] speed  The updated speed (km/h)
@@ -131,6 +264,18 @@ typedef void(*location_position_updated_cb)(double latitude, double longitude, d
  */
 typedef void(*location_velocity_updated_cb)(double speed, double direction, double climb, time_t timestamp, void *user_data);
 
+/**
+ * @brief Called at defined interval with updated velocity information and the time it was received.
+ * @param[in] speed  The updated speed (km/h)
+ * @param[in] direction The updated direction (in degrees from the north)
+ * @param[in] climb  The updated climb (km/h)
+ * @param[in] time  The time of the update, valid only in this callback
+ * @param[in] user_data  The user data passed from the callback registration function
+ * @pre location_manager_start() will invoke this callback if you register this callback using location_manager_set_velocity_updated_ns_cb()
+ * @see location_manager_set_velocity_updated_ns_cb()
+ */
+typedef void(*location_velocity_updated_ns_cb)(double speed, double direction, double climb, const location_timestamp_s *time, void *user_data);
+
 /**
  * @brief Called when the state of location service is changed from enabled to disabled or vice versa.
  * @param[in] state The service state
@@ -158,10 +303,37 @@ typedef void(*location_service_state_changed_cb)(location_service_state_e state,
  */
 typedef void(*location_zone_changed_cb)(location_boundary_state_e state, double latitude, double longitude, double altitude, time_t timestamp, void *user_data);
 
+/**
+ * @brief Called when the user defined zones are entered or exited, with the time it was received.
+ * @param[in] state  The boundary state
+ * @param[in] latitude  The updated latitude [-90.0 ~ 90.0] (degrees)
+ * @param[in] longitude The updated longitude [-180.0 ~ 180.0] (degrees)
+ * @param[in] altitude  The updated altitude (meters)
+ * @param[in] time  The time of the update, valid only in this callback
+ * @param[in] user_data  The user data passed from the callback registration function
+ * @pre location_manager_start() will invoke this callback if you register this callback using location_manager_set_zone_changed_ns_cb()
+ * @see location_manager_set_zone_changed_ns_cb()
+ */
+typedef void(*location_zone_changed_ns_cb)(location_boundary_state_e state, double latitude, double longitude, double altitude, const location_timestamp_s *time, void *user_data);
+
+/**
+ * @brief Called when the position enters, leaves or dwells in a geofence.
+ * @param[in] bounds  The geofence, as passed to location_manager_add_geofence()
+ * @param[in] event  The geofence event
+ * @param[in] fix  The fix that triggered the event, valid only in this callback
+ * @param[in] user_data  The user data passed from the callback registration function
+ * @pre location_manager_start() will invoke this callback if you register this callback using location_manager_set_geofence_event_cb()
+ * @see location_manager_set_geofence_event_cb()
+ * @see location_manager_add_geofence()
+ */
+typedef void(*location_geofence_event_cb)(location_bounds_h bounds, location_geofence_event_e event, const location_fix_s *fix, void *user_data);
+
 /**
  * @brief Gets called iteratively to notify you of location bounds.
+ * @remarks @a bounds belongs to the location manager and is valid only in this callback. Do not release it.
  * @param[in] bounds  The location bounds handle
  * @param[in] user_data  The user data passed from the callback registration function
+ * @return @c true to continue with the next iteration of the loop, \n @c false to break out of the loop
  * @pre location_manager_foreach_boundary() will invoke this callback.
  * @see location_manager_foreach_boundary()
  */
@@ -191,12 +363,36 @@ bool location_manager_is_supported_method(location_method_e method);
  */
 int location_manager_create(location_method_e method, location_manager_h* manager);
 
+/**
+ * @brief Creates a new location manager sharing the location service session of the other shared managers of the same method.
+ * @details The shared managers of a method use a single session: the service sees one client and every update is received
+ * once, then delivered to each started manager. Creating a manager while others of its method exist does not open a new session.
+ * The session runs while at least one of its managers is started. \n
+ * The managers keep their own callbacks, cache, history and filters, but share what the service holds for the session:
+ * the update intervals are the shortest requested by any of the managers, and the boundaries added with
+ * location_manager_add_boundary() are evaluated for all of them, so location_zone_changed_cb() is invoked on every started manager.
+ * @remarks @a manager must be released location_manager_destroy() by you.
+ * A callback of a shared manager may stop or destroy any manager of its method, itself included. The managers it stopped
+ * or destroyed do not receive the rest of the update.
+ * @param[in] method The location method
+ * @param[out] manager  A location manager handle to be newly created on success
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_OUT_OF_MEMORY Out of memory
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER	Invalid parameter
+ * @retval #LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE Service not available
+ * @see location_manager_create()
+ * @see location_manager_destroy()
+ */
+int location_manager_create_shared(location_method_e method, location_manager_h* manager);
+
 /**
  * @brief Releases the location manager.
+ * @remarks This function must not be called from a callback running on the dispatch thread, see location_manager_set_dispatch_thread_enabled().
  * @param[in] manager The location manager handle
  * @return 0 on success, otherwise a negative error value.
  * @retval #LOCATIONS_ERROR_NONE Successful
- * @retval #LOCATIONS_ERROR_INVALID_PARAMETER	Invalid parameter
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER	Invalid parameter, or called on the dispatch thread
  * @see location_manager_create()
 */
 int location_manager_destroy(location_manager_h manager);
@@ -220,6 +416,8 @@ int location_manager_destroy(location_manager_h manager);
  * Starting and stopping the service is in the scope of the given location manager only (if there's more than one manager,
  * starting and stopping should be executed for each of them separately).
  *
+ * Starting a manager that is already started does nothing and returns #LOCATIONS_ERROR_NONE.
+ *
  * @param[in]   manager The location manager handle
  * @return 0 on success, otherwise a negative error value.
  * @retval #LOCATIONS_ERROR_NONE Successful
@@ -248,7 +446,8 @@ int location_manager_start(location_manager_h manager);
  * #location_manager_set_service_state_changed_cb() will be called, with #LOCATIONS_SERVICE_DISABLED as first argument.
  * When that happens, the service is stopped and the user is notified.
  *
- * You can stop and start the location manager as needed.
+ * You can stop and start the location manager as needed, each callback is still invoked once per event.
+ * Stopping a manager that is not started does nothing and returns #LOCATIONS_ERROR_NONE.
  *
  * @param[in]   manager The location manager handle
  * @return 0 on success, otherwise a negative error value.
@@ -289,8 +488,57 @@ int location_manager_add_boundary(location_manager_h manager, const location_bou
  */
 int location_manager_remove_boundary(location_manager_h manager, const location_bounds_h bounds);
 
+/**
+ * @brief Adds several bounds for a given location manager in one call.
+ * @details Either all bounds are added, or none of them when an error is returned.
+ * @param[in] manager The location manager handle
+ * @param[in] bounds The array of location bounds handles
+ * @param[in] count The number of bounds in @a bounds
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #LOCATIONS_ERROR_OUT_OF_MEMORY Out of memory
+ * @see location_manager_add_boundary()
+ * @see location_manager_remove_boundaries()
+ * @see location_manager_replace_boundaries()
+ */
+int location_manager_add_boundaries(location_manager_h manager, const location_bounds_h *bounds, int count);
+
+/**
+ * @brief Deletes several bounds for a given location manager in one call.
+ * @details When an error is returned, the bounds before the failing one have been deleted.
+ * @param[in] manager The location manager handle
+ * @param[in] bounds The array of location bounds handles
+ * @param[in] count The number of bounds in @a bounds
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #LOCATIONS_ERROR_OUT_OF_MEMORY Out of memory
+ * @see location_manager_remove_boundary()
+ * @see location_manager_add_boundaries()
+ */
+int location_manager_remove_boundaries(location_manager_h manager, const location_bounds_h *bounds, int count);
+
+/**
+ * @brief Replaces all bounds of a given location manager.
+ * @details The replacement is all or nothing: @a bounds are checked and added first, and the bounds added so far
+ * are deleted only once all of them are added. When an error is returned, the bounds of @a manager are left as they were.
+ * A bounds equal to one already added is kept as it is, without being deleted and added again.
+ * @param[in] manager The location manager handle
+ * @param[in] bounds The array of location bounds handles, may be @c NULL if @a count is 0
+ * @param[in] count The number of bounds in @a bounds, 0 to delete all bounds
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid parameter
+ * @retval #LOCATIONS_ERROR_OUT_OF_MEMORY Out of memory
+ * @see location_manager_add_boundaries()
+ * @see location_manager_remove_boundaries()
+ */
+int location_manager_replace_boundaries(location_manager_h manager, const location_bounds_h *bounds, int count);
+
 /**
  * @brief  Retrieves all location bounds by invoking a specific callback for each locatoin bounds
+ * @remarks Boundaries must not be added or removed from the callback.
  * @param[in] manager  The location manager handle
  * @param[in] callback The iteration callback
  * @param[in] user_data	The user data to be passed to the callback function
@@ -419,6 +667,139 @@ int location_manager_get_last_velocity(location_manager_h manager, double *climb
  */
 int location_manager_get_last_accuracy(location_manager_h manager, location_accuracy_level_e *level, double *horizontal, double *vertical);
 
+/**
+ * @brief Makes the position getters answer with the last fix delivered to the location manager.
+ * @details
+ * When enabled, location_manager_get_position(), location_manager_get_velocity(), location_manager_get_accuracy() and location_manager_get_fix()
+ * return the last position and velocity delivered to the started location manager without querying the location service.
+ * Until the first update is delivered they still query the service. The cache can be read from any thread.
+ * It is disabled by default, for callers which need a fresh query every time.
+ * @param[in]   manager     The location manager handle
+ * @param[in]   enable      @c true to answer from the last delivered fix, @c false to query the location service
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid argument
+ * @see location_manager_get_position()
+ * @see location_manager_get_fix()
+ */
+int location_manager_set_fix_cache_enabled(location_manager_h manager, bool enable);
+
+/**
+ * @brief Gets the current position together with its velocity, accuracy, fix status and satellites used.
+ * @details
+ * The position and its accuracy are queried once from the location service, as location_manager_get_position() does.
+ * The velocity and the number of satellites used are the last ones delivered to the location manager while it is started, and 0 if none was delivered yet.
+ * Unlike location_manager_get_position(), the values are not replaced by -1 when there is no fix; check @a status of the fix instead.
+ * @param[in]   manager     The location manager handle
+ * @param[out]  fix         The fix to be filled
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid argument
+ * @retval #LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE Service not available
+ * @pre The location service state must be #LOCATIONS_SERVICE_ENABLED with location_manager_start()
+ * @see location_manager_get_position()
+ */
+int location_manager_get_fix(location_manager_h manager, location_fix_s *fix);
+
+/**
+ * @brief Predicts the position at a given time from the last position and velocity updates.
+ * @details The last position is moved along the great circle of the last direction by the distance the last speed
+ * covers since it was received, plus @a offset. The altitude follows the last climb. While smoothing is enabled,
+ * the smoothed fix is used instead. Nothing is requested from the location service.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   offset      The time of the prediction [-3600 ~ 3600] (seconds from now)
+ * @param[out]  altitude    The predicted altitude (meters), -1 without a 3D fix
+ * @param[out]  latitude    The predicted latitude [-90.0 ~ 90.0] (degrees)
+ * @param[out]  longitude   The predicted longitude [-180.0 ~ 180.0] (degrees)
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE  No position update was received yet
+ * @pre The location service state must be #LOCATIONS_SERVICE_ENABLED with location_manager_start()
+ * @see location_manager_set_smoothing_enabled()
+ */
+int location_manager_predict_position(location_manager_h manager, double offset, double *altitude, double *latitude, double *longitude);
+
+/**
+ * @brief Enables or disables the smoothing of the position updates.
+ * @details While enabled, the position and velocity updates feed a constant velocity Kalman filter weighting
+ * every position by its accuracy. The result is available from location_manager_get_smoothed_fix() and
+ * location_smoothed_updated_cb(); the other getters and callbacks keep reporting the raw updates.
+ * Enabling restarts the filter from the next position update.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   enable      @c true to enable the smoothing, @c false to disable it
+ * @param[in]   acceleration    The expected acceleration of the device (0 ~ 100] (meters per second squared), ignored when disabling. \n
+ *                              Lower values smooth more, higher values follow changes of speed and direction faster.
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see location_manager_get_smoothed_fix()
+ * @see location_manager_set_smoothed_updated_cb()
+ */
+int location_manager_set_smoothing_enabled(location_manager_h manager, bool enable, double acceleration);
+
+/**
+ * @brief Gets the latest smoothed fix.
+ * @details The horizontal and vertical accuracies of @a fix are the standard deviations estimated by the filter.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[out]  fix         The smoothed fix
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE  Smoothing is disabled or no position update was received since it was enabled
+ * @see location_manager_set_smoothing_enabled()
+ */
+int location_manager_get_smoothed_fix(location_manager_h manager, location_fix_s *fix);
+
+/**
+ * @brief Gets the most recent fixes delivered to the location manager.
+ * @details
+ * While the location manager is started, every position update is recorded with the accuracy of the position and the last velocity update,
+ * whether or not a callback is registered. Up to #LOCATION_MANAGER_HISTORY_CAPACITY fixes are kept; older ones are overwritten.
+ * @param[in]   manager     The location manager handle
+ * @param[out]  fixes       The array to be filled with up to @a max_count fixes, oldest first
+ * @param[in]   max_count   The number of fixes @a fixes can hold
+ * @param[out]  count       The number of fixes copied
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid argument
+ * @pre The location manager handle must be created by location_manager_create()
+ * @see location_manager_get_history_since()
+ * @see location_manager_clear_history()
+ */
+int location_manager_get_history(location_manager_h manager, location_fix_s *fixes, int max_count, int *count);
+
+/**
+ * @brief Gets the recorded fixes newer than the given time.
+ * @details
+ * Fixes whose timestamp is later than @a since are copied oldest first. If there are more than @a max_count of them, the oldest @a max_count are copied,
+ * so a caller can continue from the timestamp of the last fix it received.
+ * @param[in]   manager     The location manager handle
+ * @param[in]   since       The time after which fixes are copied
+ * @param[out]  fixes       The array to be filled with up to @a max_count fixes, oldest first
+ * @param[in]   max_count   The number of fixes @a fixes can hold
+ * @param[out]  count       The number of fixes copied
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid argument
+ * @pre The location manager handle must be created by location_manager_create()
+ * @see location_manager_get_history()
+ */
+int location_manager_get_history_since(location_manager_h manager, time_t since, location_fix_s *fixes, int max_count, int *count);
+
+/**
+ * @brief Discards the recorded fixes.
+ * @param[in]   manager     The location manager handle
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid argument
+ * @see location_manager_get_history()
+ */
+int location_manager_clear_history(location_manager_h manager);
+
 /**
  * @brief Registers a callback function to be invoked at defined interval with updated position information.
  *
@@ -446,6 +827,111 @@ int location_manager_set_position_updated_cb(location_manager_h manager, locatio
  */
 int location_manager_unset_position_updated_cb(location_manager_h manager);
 
+/**
+ * @brief Registers a callback function to be invoked at defined interval with updated position information and its reception time.
+ * @details The callback is called in addition to location_position_updated_cb() and obeys the same distance filter.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to register
+ * @param[in]   interval   The interval [1 ~ 120] (seconds)
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @post  location_position_updated_ns_cb() will be invoked
+ * @see location_manager_unset_position_updated_ns_cb()
+ * @see location_position_updated_ns_cb()
+ */
+int location_manager_set_position_updated_ns_cb(location_manager_h manager, location_position_updated_ns_cb callback, int interval, void *user_data);
+
+/**
+ * @brief	Unregisters the callback function.
+ *
+ * @param[in]   manager The location manager handle
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see location_manager_set_position_updated_ns_cb()
+ */
+int location_manager_unset_position_updated_ns_cb(location_manager_h manager);
+
+/**
+ * @brief Registers a callback function to be invoked with the smoothed fix after every position update.
+ * @remarks The position interval is shared with location_manager_set_position_updated_cb().
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to register
+ * @param[in]   interval   The position interval [1 ~ 120] (seconds)
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @pre  Smoothing is enabled with location_manager_set_smoothing_enabled()
+ * @post  location_smoothed_updated_cb() will be invoked
+ * @see location_manager_unset_smoothed_updated_cb()
+ */
+int location_manager_set_smoothed_updated_cb(location_manager_h manager, location_smoothed_updated_cb callback, int interval, void *user_data);
+
+/**
+ * @brief	Unregisters the callback function.
+ *
+ * @param[in]   manager The location manager handle
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see location_manager_set_smoothed_updated_cb()
+ */
+int location_manager_unset_smoothed_updated_cb(location_manager_h manager);
+
+/**
+ * @brief Sets the minimum displacement between two positions delivered to location_position_updated_cb().
+ * @details Position updates closer than @a distance to the last delivered position are not delivered.
+ * The first update after location_manager_set_position_updated_cb() is always delivered.
+ * Updates without fix are delivered too, but never become the position the next updates are compared with.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   distance    The minimum displacement (meters), 0 to deliver every update
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see location_manager_set_position_updated_cb()
+ */
+int location_manager_set_position_distance_filter(location_manager_h manager, double distance);
+
+/**
+ * @brief Registers a callback function to be invoked with batches of position fixes.
+ * @details The fixes are accumulated and delivered together once @a batch_count of them are pending,
+ * or @a batch_period seconds after the oldest pending one was received, whichever comes first.
+ * Pending fixes are also delivered when the manager is stopped.
+ *
+ * @remarks The position interval is shared with location_manager_set_position_updated_cb().
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to register
+ * @param[in]   interval   The position interval [1 ~ 120] (seconds)
+ * @param[in]   batch_count   The number of fixes per batch [1 ~ #LOCATION_MANAGER_BATCH_CAPACITY]
+ * @param[in]   batch_period   The maximum delay of a fix [0 ~ 3600] (seconds), 0 to deliver on @a batch_count only
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @post  location_batch_updated_cb() will be invoked
+ * @see location_manager_unset_batch_updated_cb()
+ * @see location_batch_updated_cb()
+ */
+int location_manager_set_batch_updated_cb(location_manager_h manager, location_batch_updated_cb callback, int interval, int batch_count, int batch_period, void *user_data);
+
+/**
+ * @brief	Unregisters the callback function, pending fixes are discarded.
+ *
+ * @param[in]   manager The location manager handle
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see location_manager_set_batch_updated_cb()
+ */
+int location_manager_unset_batch_updated_cb(location_manager_h manager);
+
 /**
  * @brief Registers a callback function to be invoked at defined interval with updated velocity information.
  *
@@ -473,6 +959,33 @@ int location_manager_set_velocity_updated_cb(location_manager_h manager, locatio
  */
 int location_manager_unset_velocity_updated_cb(location_manager_h manager);
 
+/**
+ * @brief Registers a callback function to be invoked at defined interval with updated velocity information and its reception time.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to register
+ * @param[in]   interval   The interval [1 ~ 120] (seconds)
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @post  location_velocity_updated_ns_cb() will be invoked
+ * @see location_manager_unset_velocity_updated_ns_cb()
+ * @see location_velocity_updated_ns_cb()
+ */
+int location_manager_set_velocity_updated_ns_cb(location_manager_h manager, location_velocity_updated_ns_cb callback, int interval, void *user_data);
+
+/**
+ * @brief	Unregisters the callback function.
+ *
+ * @param[in]   manager The location manager handle
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see location_manager_set_velocity_updated_ns_cb()
+ */
+int location_manager_unset_velocity_updated_ns_cb(location_manager_h manager);
+
 /**
  * @brief Registers a callback function to be invoked when the  location service state is changed.
  *
@@ -527,6 +1040,293 @@ int location_manager_set_zone_changed_cb(location_manager_h manager, location_zo
  */
 int location_manager_unset_zone_changed_cb(location_manager_h manager);
 
+/**
+ * @brief Registers a callback function to be invoked when the previously set boundary area is entered or left, with the reception time.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to register
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @post  location_zone_changed_ns_cb() will be invoked
+ * @see location_manager_unset_zone_changed_ns_cb()
+ * @see location_zone_changed_ns_cb()
+ */
+int location_manager_set_zone_changed_ns_cb(location_manager_h manager, location_zone_changed_ns_cb callback, void *user_data);
+
+/**
+ * @brief	Unregisters the callback function.
+ * @param[in]	manager	The location manager handle
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE	Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see location_manager_set_zone_changed_ns_cb()
+ */
+int location_manager_unset_zone_changed_ns_cb(location_manager_h manager);
+
+/**
+ * @brief Adds a listener invoked with the updated position, in addition to the callback set with location_manager_set_position_updated_cb().
+ * @details Any number of listeners can be added, they are invoked in the order they were added.
+ * Listeners can be added and removed from any thread, including from a callback.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to add
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @param[out]  listener_id The identifier of the listener, to pass to location_manager_remove_listener()
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_OUT_OF_MEMORY      Out of memory
+ * @post  location_position_updated_cb() will be invoked
+ * @see location_manager_remove_listener()
+ */
+int location_manager_add_position_updated_listener(location_manager_h manager, location_position_updated_cb callback, void *user_data, int *listener_id);
+
+/**
+ * @brief Adds a listener invoked with the updated velocity, in addition to the callback set with location_manager_set_velocity_updated_cb().
+ * @details Any number of listeners can be added, they are invoked in the order they were added.
+ * Listeners can be added and removed from any thread, including from a callback.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to add
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @param[out]  listener_id The identifier of the listener, to pass to location_manager_remove_listener()
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_OUT_OF_MEMORY      Out of memory
+ * @post  location_velocity_updated_cb() will be invoked
+ * @see location_manager_remove_listener()
+ */
+int location_manager_add_velocity_updated_listener(location_manager_h manager, location_velocity_updated_cb callback, void *user_data, int *listener_id);
+
+/**
+ * @brief Adds a listener invoked with the service state changes, in addition to the callback set with location_manager_set_service_state_changed_cb().
+ * @details Any number of listeners can be added, they are invoked in the order they were added.
+ * Listeners can be added and removed from any thread, including from a callback.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to add
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @param[out]  listener_id The identifier of the listener, to pass to location_manager_remove_listener()
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_OUT_OF_MEMORY      Out of memory
+ * @post  location_service_state_changed_cb() will be invoked
+ * @see location_manager_remove_listener()
+ */
+int location_manager_add_service_state_changed_listener(location_manager_h manager, location_service_state_changed_cb callback, void *user_data, int *listener_id);
+
+/**
+ * @brief Adds a listener invoked with the boundary changes, in addition to the callback set with location_manager_set_zone_changed_cb().
+ * @details Any number of listeners can be added, they are invoked in the order they were added.
+ * Listeners can be added and removed from any thread, including from a callback.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to add
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @param[out]  listener_id The identifier of the listener, to pass to location_manager_remove_listener()
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_OUT_OF_MEMORY      Out of memory
+ * @post  location_zone_changed_cb() will be invoked
+ * @see location_manager_remove_listener()
+ */
+int location_manager_add_zone_changed_listener(location_manager_h manager, location_zone_changed_cb callback, void *user_data, int *listener_id);
+
+/**
+ * @brief Removes a listener.
+ * @remarks A listener being invoked on another thread may still complete after this function returns.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   listener_id The identifier returned when the listener was added
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter, or no such listener
+ * @retval  #LOCATIONS_ERROR_OUT_OF_MEMORY      Out of memory
+ * @see location_manager_add_position_updated_listener()
+ * @see location_manager_add_velocity_updated_listener()
+ * @see location_manager_add_service_state_changed_listener()
+ * @see location_manager_add_zone_changed_listener()
+ * @see gps_status_add_satellite_updated_listener()
+ */
+int location_manager_remove_listener(location_manager_h manager, int listener_id);
+
+/**
+ * @brief Gets the time of the last position update.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[out]  time        The time of the last position update
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE  No position update was received yet
+ * @see location_manager_get_last_velocity_time()
+ */
+int location_manager_get_last_position_time(location_manager_h manager, location_timestamp_s *time);
+
+/**
+ * @brief Gets the time of the last velocity update.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[out]  time        The time of the last velocity update
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE  No velocity update was received yet
+ * @see location_manager_get_last_position_time()
+ */
+int location_manager_get_last_velocity_time(location_manager_h manager, location_timestamp_s *time);
+
+/**
+ * @brief Enables or disables the delivery of the callbacks on a dispatch thread.
+ * @details By default the callbacks run on the main loop thread, and a slow callback delays every other update.
+ * When enabled, the position, velocity, satellite, zone, service state and smoothed callbacks are queued
+ * and invoked on a thread owned by the location manager, in the order of the updates. The batch and geofence
+ * callbacks stay on the main loop thread. \n
+ * When the queue is full, events are dropped or coalesced according to @a overflow,
+ * see location_manager_get_dispatch_dropped_count().
+ * Disabling, or enabling again with other settings, waits for the queued events to be delivered.
+ * @remarks This function must not be called from a callback running on the dispatch thread.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   enable      @c true to deliver on the dispatch thread, @c false to deliver on the main loop thread
+ * @param[in]   queue_size  The number of queued events [1 ~ #LOCATION_MANAGER_DISPATCH_QUEUE_MAX], rounded up to a power of two. Ignored when disabling.
+ * @param[in]   overflow    The overflow policy. Ignored when disabling.
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_OUT_OF_MEMORY      Out of memory
+ * @see location_manager_get_dispatch_dropped_count()
+ */
+int location_manager_set_dispatch_thread_enabled(location_manager_h manager, bool enable, int queue_size, location_dispatch_overflow_e overflow);
+
+/**
+ * @brief Gets the number of events the dispatch thread never delivered because its queue was full.
+ * @details The counts accumulate over the lifetime of the location manager.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[out]  dropped     The number of events dropped with #LOCATIONS_DISPATCH_OVERFLOW_DROP_OLDEST
+ * @param[out]  coalesced   The number of events replaced by a newer one with #LOCATIONS_DISPATCH_OVERFLOW_COALESCE, counted when the newer one is delivered
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see location_manager_set_dispatch_thread_enabled()
+ */
+int location_manager_get_dispatch_dropped_count(location_manager_h manager, unsigned int *dropped, unsigned int *coalesced);
+
+/**
+ * @brief Lets the location manager schedule the position updates from the observed speed and fix quality.
+ * @details The interval between fixes is the distance of @a policy over the speed of the device, within
+ * [@a min_interval, @a max_interval]: the shortest when driving fast, the longest when stationary.
+ * The speed is the reported one, or the one of the displacement between fixes if it is higher.
+ * Until a fix is accurate enough for the policy, the interval is @a min_interval.
+ *
+ * From an interval of 30 seconds, the service is stopped after each good fix and started again shortly
+ * before the next one is due. The service state changes caused by the duty cycle are not reported to
+ * location_service_state_changed_cb().
+ * @remarks The duty cycle overrides the interval of the position callbacks until location_manager_unset_duty_cycle().
+ * It is not available to the managers created with location_manager_create_shared().
+ *
+ * @param[in]   manager       The location manager handle
+ * @param[in]   policy        The distance between fixes
+ * @param[in]   min_interval  The shortest interval in seconds [1 ~ 120]
+ * @param[in]   max_interval  The longest interval in seconds [@a min_interval ~ #LOCATION_MANAGER_DUTY_CYCLE_INTERVAL_MAX]
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter, or @a manager is shared
+ * @retval  #LOCATIONS_ERROR_OUT_OF_MEMORY      Out of memory
+ * @retval  #LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE  The service stopped by the duty cycle failed to start again, the duty cycle retries it
+ * @see location_manager_unset_duty_cycle()
+ * @see location_manager_get_duty_cycle_interval()
+ */
+int location_manager_set_duty_cycle(location_manager_h manager, location_duty_cycle_policy_e policy, int min_interval, int max_interval);
+
+/**
+ * @brief Stops the duty cycle, the position callbacks get their own interval back.
+ * @remarks If the duty cycle stopped the service and it fails to start again, the duty cycle is kept and retries it.
+ * @param[in]   manager     The location manager handle
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE  The service failed to start again
+ * @see location_manager_set_duty_cycle()
+ */
+int location_manager_unset_duty_cycle(location_manager_h manager);
+
+/**
+ * @brief Gets the current interval between fixes of the duty cycle.
+ * @param[in]   manager     The location manager handle
+ * @param[out]  interval    The interval in seconds
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter, or no duty cycle is set
+ * @see location_manager_set_duty_cycle()
+ */
+int location_manager_get_duty_cycle_interval(location_manager_h manager, int *interval);
+
+/**
+ * @brief Adds a geofence evaluated by the location manager itself on every position update.
+ * @details Unlike location_manager_add_boundary(), the geofences are evaluated in the calling process
+ * and reported through location_geofence_event_cb() with hysteresis and dwell detection.
+ * @remarks The manager refers to @a bounds without copying it, so it must not be destroyed while it is added.
+ * @param[in]	manager	The location manager handle
+ * @param[in]	bounds	The geofence
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE	Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter, or @a bounds is already added
+ * @retval  #LOCATIONS_ERROR_OUT_OF_MEMORY  Out of memory
+ * @see location_manager_remove_geofence()
+ * @see location_manager_set_geofence_event_cb()
+ */
+int location_manager_add_geofence(location_manager_h manager, location_bounds_h bounds);
+
+/**
+ * @brief Removes a geofence added with location_manager_add_geofence().
+ * @details It may be called from location_geofence_event_cb(), the events of the geofence not delivered yet are then dropped.
+ * @param[in]	manager	The location manager handle
+ * @param[in]	bounds	The geofence
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE	Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter, or @a bounds is not added
+ * @see location_manager_add_geofence()
+ */
+int location_manager_remove_geofence(location_manager_h manager, location_bounds_h bounds);
+
+/**
+ * @brief Registers a callback function to be invoked on geofence events.
+ * @details A geofence is entered once a position lies inside it by at least @a buffer meters plus the horizontal
+ * accuracy of the fix, and left once a position lies outside it by at least as much.
+ * Positions in between keep the previous state, so a geofence smaller than the accuracy is entered only by more accurate fixes.
+ * #LOCATIONS_GEOFENCE_DWELL is reported once per entry, when a position update comes @a dwell_time seconds or more after the entry.
+ * @remarks Every geofence starts outside when the callback is registered.
+ * @param[in]	manager	The location manager handle
+ * @param[in]	callback	The callback function to register
+ * @param[in]	buffer	The hysteresis buffer [0 ~ 10000] (meters)
+ * @param[in]	dwell_time	The dwell time [0 ~ 86400] (seconds), 0 to disable #LOCATIONS_GEOFENCE_DWELL
+ * @param[in]	user_data	The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE	Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @post location_geofence_event_cb() will be invoked
+ * @see location_manager_unset_geofence_event_cb()
+ * @see location_geofence_event_cb()
+ */
+int location_manager_set_geofence_event_cb(location_manager_h manager, location_geofence_event_cb callback, double buffer, int dwell_time, void *user_data);
+
+/**
+ * @brief	Unregisters the callback function.
+ * @param[in]	manager	The location manager handle
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE	Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see location_manager_set_geofence_event_cb()
+ */
+int location_manager_unset_geofence_event_cb(location_manager_h manager);
+
 /**
  * @brief Gets the distance in meters between two locations.
  * @param[in] start_latitude The starting latitude [-90.0 ~ 90.0] (degrees)
@@ -540,6 +1340,36 @@ int location_manager_unset_zone_changed_cb(location_manager_h manager);
  */
 int location_manager_get_distance(double start_latitude, double start_longitude, double end_latitude, double end_longitude, double *distance);
 
+/**
+ * @brief Gets the distances in meters between pairs of locations.
+ * @details The @a i-th distance is between @a from[i] and @a to[i]. Distances are great-circle distances on a sphere of the mean earth radius, in double precision.
+ * @remarks Nothing is allocated, so this can be called for large distance matrices.
+ * @param[in] from The starting locations
+ * @param[in] to The ending locations
+ * @param[in] n The number of pairs
+ * @param[out] out The array of @a n distances (meters) filled by this function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid argument
+ * @see location_manager_get_distances_from()
+ */
+int location_manager_get_distances(const location_coords_s *from, const location_coords_s *to, int n, double *out);
+
+/**
+ * @brief Gets the distances in meters from one location to many locations.
+ * @details The @a i-th distance is between @a from and @a to[i]. Distances are great-circle distances on a sphere of the mean earth radius, in double precision.
+ * @remarks Nothing is allocated, so this can be called for large distance matrices.
+ * @param[in] from The starting location
+ * @param[in] to The ending locations
+ * @param[in] n The number of ending locations
+ * @param[out] out The array of @a n distances (meters) filled by this function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid argument
+ * @see location_manager_get_distances()
+ */
+int location_manager_get_distances_from(location_coords_s from, const location_coords_s *to, int n, double *out);
+
 /**
  * @brief	Sends command to the server.
  * @param[in]	cmd The command string to be sent
@@ -589,6 +1419,17 @@ typedef bool(*gps_status_get_satellites_cb)(unsigned int azimuth, unsigned int e
  */
 typedef void(*gps_status_satellite_updated_cb)(int num_of_active, int num_of_inview,  time_t timestamp, void *user_data);
 
+/**
+ * @brief Called at defined interval with updated satellite information and the time it was received.
+ * @param[in] num_of_active  The number of active satellites
+ * @param[in] num_of_inview  The number of satellites in view
+ * @param[in] time  The time of the update, valid only in this callback
+ * @param[in] user_data  The user data passed from the callback registration function
+ * @pre location_manager_start() will invoke this callback if you register this callback using gps_status_set_satellite_updated_ns_cb()
+ * @see gps_status_set_satellite_updated_ns_cb()
+ */
+typedef void(*gps_status_satellite_updated_ns_cb)(int num_of_active, int num_of_inview, const location_timestamp_s *time, void *user_data);
+
 /**
  * @brief Gets the GPS NMEA data.
  * @remarks This call is valid only for location managers with #LOCATIONS_METHOD_GPS method.\n
@@ -606,6 +1447,36 @@ typedef void(*gps_status_satellite_updated_cb)(int num_of_active, int num_of_inv
  */
 int gps_status_get_nmea(location_manager_h manager, char **nmea);
 
+/**
+ * @brief Called for each sentence of the GPS NMEA data.
+ * @param[in] sentence  The sentence from its '$', without the line ending and not null-terminated. Valid only in this callback.
+ * @param[in] length  The length of @a sentence in bytes
+ * @param[in] user_data  The user data passed from the foreach function
+ * @return @c true to continue with the next iteration of the loop, \n @c false to break out of the loop
+ * @pre gps_status_foreach_nmea_sentence() will invoke this callback.
+ * @see gps_status_foreach_nmea_sentence()
+ */
+typedef bool (*gps_status_nmea_sentence_cb)(const char *sentence, int length, void *user_data);
+
+/**
+ * @brief Invokes the callback function for each sentence of the GPS NMEA data.
+ * @details Unlike gps_status_get_nmea(), the data is not copied for the caller and the sentences are not split into strings.
+ * They can be given to location_nmea_parser_feed().
+ * @remarks This call is valid only for location managers with #LOCATIONS_METHOD_GPS method.
+ * @param[in]	manager The location manager handle
+ * @param[in]	callback The callback function to invoke
+ * @param[in]	user_data The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval #LOCATIONS_ERROR_NONE Successful
+ * @retval #LOCATIONS_ERROR_INVALID_PARAMETER Invalid argument
+ * @retval #LOCATIONS_ERROR_INCORRECT_METHOD Incorrect method
+ * @retval #LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE Service not available
+ * @pre The location service state must be #LOCATIONS_SERVICE_ENABLED with location_manager_start()
+ * @post It invokes gps_status_nmea_sentence_cb().
+ * @see gps_status_get_nmea()
+ */
+int gps_status_foreach_nmea_sentence(location_manager_h manager, gps_status_nmea_sentence_cb callback, void *user_data);
+
 /**
  * @brief Gets the information of satellites.
  * @remarks This call is valid only for location managers with #LOCATIONS_METHOD_GPS method.
@@ -650,6 +1521,63 @@ int gps_status_set_satellite_updated_cb(location_manager_h manager, gps_status_s
  */
 int gps_status_unset_satellite_updated_cb(location_manager_h manager);
 
+/**
+ * @brief Registers a callback function to be invoked at defined interval with updated satellite information and its reception time.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to register
+ * @param[in]   interval   The interval [1 ~ 120] (seconds)
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @post  gps_status_satellite_updated_ns_cb() will be invoked
+ * @see gps_status_unset_satellite_updated_ns_cb()
+ * @see gps_status_satellite_updated_ns_cb()
+ */
+int gps_status_set_satellite_updated_ns_cb(location_manager_h manager, gps_status_satellite_updated_ns_cb callback, int interval, void *user_data);
+
+/**
+ * @brief	Unregisters the callback function.
+ *
+ * @param[in]   manager The location manager handle
+ * @return  0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @see gps_status_set_satellite_updated_ns_cb()
+ */
+int gps_status_unset_satellite_updated_ns_cb(location_manager_h manager);
+
+/**
+ * @brief Adds a listener invoked with the updated satellite information, in addition to the callback set with gps_status_set_satellite_updated_cb().
+ * @details Any number of listeners can be added, they are invoked in the order they were added.
+ * Listeners can be added and removed from any thread, including from a callback.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[in]   callback    The callback function to add
+ * @param[in]   user_data   The user data to be passed to the callback function
+ * @param[out]  listener_id The identifier of the listener, to pass to location_manager_remove_listener()
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_OUT_OF_MEMORY      Out of memory
+ * @post  gps_status_satellite_updated_cb() will be invoked
+ * @see location_manager_remove_listener()
+ */
+int gps_status_add_satellite_updated_listener(location_manager_h manager, gps_status_satellite_updated_cb callback, void *user_data, int *listener_id);
+
+/**
+ * @brief Gets the time of the last satellite update.
+ *
+ * @param[in]   manager     The location manager handle
+ * @param[out]  time        The time of the last satellite update
+ * @return 0 on success, otherwise a negative error value.
+ * @retval  #LOCATIONS_ERROR_NONE               Successful
+ * @retval  #LOCATIONS_ERROR_INVALID_PARAMETER  Invalid parameter
+ * @retval  #LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE  No satellite update was received yet
+ */
+int gps_status_get_last_satellite_time(location_manager_h manager, location_timestamp_s *time);
+
 /**
  * @brief Invokes the callback function for each satellite.
  * @remarks This function is valid only for location managers with the #LOCATIONS_METHOD_GPS method.
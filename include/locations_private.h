@@ -17,9 +17,13 @@
 #ifndef __TIZEN_LOCATION_LOCATIONS_PRIVATE_H__
 #define	__TIZEN_LOCATION_LOCATIONS_PRIVATE_H__
 
+#include <math.h>
+#include <pthread.h>
 #include <location/location.h>
 #include <locations.h>
 #include <location_bounds.h>
+#include <location_bounds_set.h>
+#include <location_nmea.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,18 +35,381 @@ typedef enum {
 	_LOCATIONS_EVENT_TYPE_VELOCITY,
 	_LOCATIONS_EVENT_TYPE_BOUNDARY,
 	_LOCATIONS_EVENT_TYPE_SATELLITE,
-	_LOCATIONS_EVENT_TYPE_FOREACH_BOUNDS,
+	_LOCATIONS_EVENT_TYPE_BATCH,
+	_LOCATIONS_EVENT_TYPE_GEOFENCE,
+	_LOCATIONS_EVENT_TYPE_SMOOTHED,
+	_LOCATIONS_EVENT_TYPE_POSITION_NS,
+	_LOCATIONS_EVENT_TYPE_VELOCITY_NS,
+	_LOCATIONS_EVENT_TYPE_BOUNDARY_NS,
+	_LOCATIONS_EVENT_TYPE_SATELLITE_NS,
 	_LOCATIONS_EVENT_TYPE_NUM
 }_location_event_e;
 
+#define LOCATIONS_EARTH_RADIUS_MIN	6356752.3	/* polar radius (meters) */
+#define LOCATIONS_EARTH_RADIUS_MEAN	6371008.8	/* mean radius (meters) */
+
+#define LOCATIONS_DEG_TO_RAD(deg)	((deg) * (M_PI / 180.0))
+
+/* Central angle (radians) between two points given in radians, with the cosines of their latitudes */
+static inline double _location_haversine_angle(double lat1, double lon1, double cos_lat1, double lat2, double lon2, double cos_lat2)
+{
+	double sin_dlat = sin((lat2 - lat1) / 2);
+	double sin_dlon = sin((lon2 - lon1) / 2);
+	double h = sin_dlat * sin_dlat + cos_lat1 * cos_lat2 * sin_dlon * sin_dlon;
+	return 2 * asin(sqrt(h < 1 ? h : 1));
+}
+
+typedef struct _location_rect_s{
+	double min_latitude;
+	double max_latitude;
+	double min_longitude;
+	double max_longitude;
+} _location_rect_s;
+
+/* Uniform grid over a polygon for location_bounds_prepare().
+   Cell (row, col) covers [min_latitude + row * cell_latitude, min_latitude + (row + 1) * cell_latitude]
+   and the same in longitude. edge_list[cell_start[cell] .. cell_start[cell + 1]) are the edges
+   (k, k + 1) touching the cell, and corner[cell] is the inside state of its top left corner. */
+typedef struct _location_polygon_grid_s{
+	int rows;
+	int cols;
+	double min_latitude;
+	double min_longitude;
+	double cell_latitude;
+	double cell_longitude;
+	int* cell_start;
+	int* edge_list;
+	unsigned char* corner;
+} _location_polygon_grid_s;
+
+typedef struct _location_bounds_s{
+	location_bounds_type_e type;
+	LocationBoundary* boundary;
+	_location_rect_s bbox;
+	union {
+		struct {
+			location_coords_s top_left;
+			location_coords_s bottom_right;
+		} rect;
+		struct {
+			location_coords_s center;
+			double radius;
+			/* Precomputed for the containment test, angles in radians */
+			double latitude;
+			double longitude;
+			double cos_latitude;
+			double angle;
+			bool is_approximate;
+			double inner_square;
+			double outer_square;
+		} circle;
+		struct {
+			int length;
+			double* latitude;
+			double* longitude;
+			_location_polygon_grid_s* grid;
+		} polygon;
+	};
+} location_bounds_s;
+
+LocationBoundary* _location_bounds_get_boundary(location_bounds_s* bounds);
+/* Deep copy without the library boundary or the prepared grid */
+location_bounds_s* _location_bounds_clone(const location_bounds_s* bounds);
+bool _location_bounds_equals(const location_bounds_s* a, const location_bounds_s* b);
+/* Distance (meters) from a point to the boundary line of the bounds, whichever side the point is on */
+double _location_bounds_get_edge_distance(const location_bounds_s* bounds, double latitude, double longitude);
+
+typedef enum {
+	_LOCATION_POLYGON_KERNEL_AUTO,		/* Best kernel the CPU supports */
+	_LOCATION_POLYGON_KERNEL_SCALAR,
+	_LOCATION_POLYGON_KERNEL_SSE2,
+	_LOCATION_POLYGON_KERNEL_AVX2,
+} _location_polygon_kernel_e;
+
+bool _location_polygon_contains(const location_bounds_s* bounds, double latitude, double longitude);
+int _location_polygon_prepare(location_bounds_s* bounds, int grid_resolution);
+void _location_polygon_unprepare(location_bounds_s* bounds);
+bool _location_polygon_set_kernel(_location_polygon_kernel_e kernel);
+_location_polygon_kernel_e _location_polygon_get_kernel(void);
+
+#define _LOCATION_BOUNDS_SET_NODE_MAX	16
+#define _LOCATION_BOUNDS_SET_NODE_MIN	6
+
+/* R-tree node. Leaf entries point to location_bounds_s, the others to child nodes.
+   One extra slot holds the overflowing entry until the node is split. */
+typedef struct _location_bounds_set_node_s{
+	struct _location_bounds_set_node_s* parent;
+	bool is_leaf;
+	int count;
+	_location_rect_s rect[_LOCATION_BOUNDS_SET_NODE_MAX + 1];
+	void* child[_LOCATION_BOUNDS_SET_NODE_MAX + 1];
+} _location_bounds_set_node_s;
+
+typedef struct _location_bounds_set_s{
+	_location_bounds_set_node_s* root;
+	int count;			/* bounds in the tree and in pending */
+	GList* pending;			/* location_bounds_s* a removal could not re-insert for lack of memory, searched linearly */
+} location_bounds_set_s;
+
+/* The sentence in progress is kept only when a chunk of data ends inside it */
+typedef struct _location_nmea_parser_s{
+	location_nmea_record_cb callback;
+	void* user_data;
+	char sentence[LOCATION_NMEA_SENTENCE_MAX];
+	int length;			/* bytes of the pending sentence, 0 between sentences */
+	unsigned int error_count;
+} location_nmea_parser_s;
+
+/* Constant velocity Kalman filter state, see location_kalman.c */
+typedef struct _location_kalman_s{
+	bool is_initialized;
+	bool has_altitude;
+	double acceleration;		/* process noise (meters per second squared) */
+	gint64 time;			/* monotonic time of the state (microseconds) */
+	double origin_latitude;		/* origin of the east/north plane (degrees) */
+	double origin_longitude;
+	double origin_cos_latitude;
+	double east;			/* meters */
+	double north;
+	double up;
+	double velocity_east;		/* meters per second */
+	double velocity_north;
+	double velocity_up;
+	double horizontal[3];		/* covariance of each of east and north: var(position), cov(position, velocity), var(velocity) */
+	double vertical[3];
+} _location_kalman_s;
+
+void _location_kalman_reset(_location_kalman_s* filter, double acceleration);
+void _location_kalman_update_position(_location_kalman_s* filter, const location_fix_s* fix, gint64 now);
+void _location_kalman_update_velocity(_location_kalman_s* filter, double speed, double direction, double climb, gint64 now);
+void _location_kalman_get_fix(const _location_kalman_s* filter, location_fix_s* fix);
+
+/* GPS duty cycle of location_manager_set_duty_cycle(), see location_duty_cycle.c */
+typedef struct _location_duty_cycle_s{
+	location_duty_cycle_policy_e policy;
+	int min_interval;		/* seconds */
+	int max_interval;
+	int interval;			/* current interval between fixes */
+	int applied_interval;		/* pos-interval of the object */
+	bool has_anchor;		/* last good fix, the speed is also estimated from the displacement since then */
+	double anchor_latitude;		/* radians */
+	double anchor_longitude;
+	long long anchor_ns;		/* monotonic */
+	long long wake_ns;		/* monotonic time the backend was last started, older velocities are stale */
+	bool is_sleeping;		/* the backend is stopped until the timer fires */
+	bool is_waking;			/* the backend was started again, its service-enabled is not reported */
+	guint timer;
+} _location_duty_cycle_s;
+
+void _location_duty_cycle_reset(_location_duty_cycle_s* duty, location_duty_cycle_policy_e policy, int min_interval, int max_interval);
+int _location_duty_cycle_update(_location_duty_cycle_s* duty, const location_fix_s* fix, double speed, long long now);
+
+typedef struct _location_latest_s{
+	location_fix_s fix;
+	bool has_position;
+	bool has_velocity;
+	location_timestamp_s position_time;	/* reception times of the updates */
+	location_timestamp_s velocity_time;
+	location_timestamp_s satellite_time;
+	bool has_satellite;
+	location_fix_s smoothed;	/* filtered fix while smoothing is enabled */
+	bool has_smoothed;
+	gint64 smoothed_time;		/* monotonic time of the filter state */
+} _location_latest_s;
+
+typedef struct _location_geofence_s{
+	location_bounds_s* bounds;
+	bool is_inside;
+	bool is_dwell_reported;
+	time_t enter_time;
+	unsigned int found_stamp;	/* stamp of the last update that found the position inside */
+	int inside_index;		/* slot in the inside array while is_inside */
+} _location_geofence_s;
+
+typedef struct _location_geofence_event_s{
+	location_bounds_s* bounds;
+	location_geofence_event_e event;
+} _location_geofence_event_s;
+
+/* Geofences are indexed in a bounds set. An update only looks at the fences containing the
+   position and at those currently inside, never at the whole collection. */
+typedef struct _location_geofence_engine_s{
+	location_bounds_set_h set;
+	GHashTable* fences;		/* location_bounds_s* -> _location_geofence_s* */
+	GPtrArray* inside;		/* _location_geofence_s* currently inside */
+	unsigned int stamp;
+	double buffer;
+	int dwell_time;
+	_location_geofence_event_s* events;	/* events of the current update, delivered once it is complete */
+	int event_count;
+	int event_capacity;
+	const location_fix_s* fix;
+	double margin;			/* buffer plus the horizontal accuracy of fix */
+} _location_geofence_engine_s;
+
+/* A user callback invocation, either delivered at once or queued for the dispatch thread.
+   The type is the callback slot; the _NS variant of the slot is invoked from the same event. */
+typedef struct _location_event_s{
+	_location_event_e type;
+	int state;			/* service or boundary state */
+	double values[3];		/* latitude, longitude, altitude or speed, direction, climb */
+	int num_of_active;
+	int num_of_inview;
+	location_timestamp_s time;
+	location_fix_s fix;		/* smoothed fix */
+} _location_event_s;
+
+/* Latest overflowed event of a type, while the dispatch coalesces */
+typedef struct _location_dispatch_slot_s{
+	unsigned int seq;		/* seqlock, odd while the signal handler writes the event */
+	int is_pending;
+	unsigned int delivered_seq;	/* seq of the last delivered event, dispatch thread only */
+	_location_event_s event;
+} _location_dispatch_slot_s;
+
+/* Single producer, single consumer ring: the signal handlers push on the main loop thread and
+   the dispatch thread pops. head and tail are free running, the slot is the index & mask.
+   Only the producer moves head. The consumer moves tail, and so does the producer with a
+   compare and swap when it drops the oldest event of a full ring. */
+typedef struct _location_dispatch_s{
+	struct _location_manager_s* handle;
+	_location_event_s* events;
+	unsigned int mask;
+	unsigned int head;
+	unsigned int tail;
+	location_dispatch_overflow_e overflow;
+	_location_dispatch_slot_s slots[_LOCATIONS_EVENT_TYPE_NUM];
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	int is_waiting;
+	int is_quit;
+} _location_dispatch_s;
+
+typedef struct _location_listener_s{
+	int id;
+	const void* cb;
+	void* user_data;
+} _location_listener_s;
+
+/* Listeners of an event type. An array is never modified once published: adding or removing a
+   listener publishes a copy, readers keep iterating the array they loaded. */
+typedef struct _location_listener_array_s{
+	int count;
+	_location_listener_s listeners[];
+} _location_listener_array_s;
+
+typedef enum {
+	_LOCATION_INTERVAL_POSITION,
+	_LOCATION_INTERVAL_VELOCITY,
+	_LOCATION_INTERVAL_SATELLITE,
+	_LOCATION_INTERVAL_NUM
+} _location_interval_e;
+
+/* Signals of the LocationObject handled by a manager that owns it */
+typedef enum {
+	_LOCATION_SIGNAL_SERVICE_ENABLED,
+	_LOCATION_SIGNAL_SERVICE_DISABLED,
+	_LOCATION_SIGNAL_SERVICE_UPDATED,
+	_LOCATION_SIGNAL_ZONE_IN,
+	_LOCATION_SIGNAL_ZONE_OUT,
+	_LOCATION_SIGNAL_NUM
+} _location_signal_e;
+
+/* LocationObject shared by the managers of a method created with location_manager_create_shared() */
+typedef struct _location_session_s{
+	LocationObject* object;
+	location_method_e method;
+	GPtrArray* managers;		/* location_manager_s*, under the session lock */
+	int start_count;		/* started managers, the object runs while it is not 0 */
+	bool is_enabled;		/* service-enabled was received since the object started */
+	struct _location_manager_s** fanout;	/* copy of the started managers a signal is fanned out to, reused */
+	int fanout_capacity;
+	int dispatch_depth;		/* signals being fanned out, under the session lock */
+	GPtrArray* retired;		/* managers destroyed during a fan-out, freed by the outermost one */
+} _location_session_s;
+
 typedef struct _location_manager_s{
 	LocationObject* object;
 	const void* user_cb[_LOCATIONS_EVENT_TYPE_NUM];
 	void* user_data[_LOCATIONS_EVENT_TYPE_NUM];
 	location_method_e method;
-	bool is_continue_foreach_bounds;
+	/* Copies of the bounds added with location_manager_add_boundary(), lent to location_manager_foreach_boundary() */
+	GPtrArray* boundaries;
+	/* Fix assembled from the service updates; position updates append it to the history ring.
+	   Written only from the signal handlers, read from any thread under the latest_seq seqlock. */
+	_location_latest_s latest;
+	unsigned int latest_seq;
+	bool is_fix_cached;		/* getters answer from latest instead of querying the service */
+	bool is_smoothing;
+	_location_kalman_s kalman;	/* written only from the signal handlers, like latest */
+	_location_duty_cycle_s* duty_cycle;	/* NULL unless location_manager_set_duty_cycle() was called */
+	pthread_mutex_t history_lock;
+	location_fix_s history[LOCATION_MANAGER_HISTORY_CAPACITY];
+	int history_head;		/* slot of the next fix */
+	int history_count;
+	/* Distance filter of location_position_updated_cb(): squared central angle and the last delivered position (radians) */
+	double filter_square;
+	bool has_reported;
+	double reported_latitude;
+	double reported_longitude;
+	double reported_cos_latitude;
+	/* Pending fixes of location_batch_updated_cb(), flushed by count or by batch_timer */
+	location_fix_s batch[LOCATION_MANAGER_BATCH_CAPACITY];
+	int batch_count;
+	int batch_max_count;
+	int batch_period;
+	guint batch_timer;
+	_location_geofence_engine_s* geofence;
+	_location_dispatch_s* dispatch;	/* NULL while the callbacks run on the main loop thread */
+	unsigned int dispatch_dropped;
+	unsigned int dispatch_coalesced;
+	/* Listeners added with the add_*_listener() functions, on top of the user_cb of each type */
+	_location_listener_array_s* listeners[_LOCATIONS_EVENT_TYPE_NUM];
+	int listener_readers;		/* callers between _location_listeners_acquire() and _release() */
+	pthread_mutex_t listener_lock;	/* serializes the writers */
+	GPtrArray* retired_listeners;	/* replaced arrays that readers may still hold */
+	int next_listener_id;
+	_location_session_s* session;	/* NULL if the manager owns its object */
+	bool is_started;
+	bool is_destroyed;		/* destroyed from a callback of its session, not freed yet */
+	gulong signal_ids[_LOCATION_SIGNAL_NUM];	/* connected on the first start, 0 before */
+	guint session_idle;		/* replays service-enabled to a manager started late */
+	int intervals[_LOCATION_INTERVAL_NUM];	/* requested intervals, 0 if never set */
 } location_manager_s;
 
+int _location_geofence_add(location_manager_s* handle, location_bounds_s* bounds);
+int _location_geofence_remove(location_manager_s* handle, location_bounds_s* bounds);
+int _location_geofence_reset(location_manager_s* handle, double buffer, int dwell_time);
+void _location_geofence_update(location_manager_s* handle, const location_fix_s* fix);
+void _location_geofence_destroy(location_manager_s* handle);
+
+int _location_listener_add(location_manager_s* handle, _location_event_e type, const void* cb, void* user_data, int* id);
+int _location_listener_remove(location_manager_s* handle, int id);
+const _location_listener_array_s* _location_listeners_acquire(location_manager_s* handle, _location_event_e type);
+void _location_listeners_release(location_manager_s* handle);
+void _location_listeners_destroy(location_manager_s* handle);
+
+/* The manager side of the signal handlers */
+void _location_manager_updated(location_manager_s* handle, guint type, gpointer data, gpointer accuracy);
+void _location_manager_state_changed(location_manager_s* handle, location_service_state_e state);
+void _location_manager_zone_changed(location_manager_s* handle, location_boundary_state_e state, LocationPosition* pos);
+/* Frees a manager whose object or session was released */
+void _location_manager_free(location_manager_s* handle);
+
+/* _location_session_acquire() returns a LOCATIONS_ERROR code, the others the LOCATION_ERROR code of the backend */
+int _location_session_acquire(location_manager_s* handle, LocationMethod method);
+int _location_session_release(location_manager_s* handle);
+int _location_session_start(location_manager_s* handle);
+int _location_session_stop(location_manager_s* handle);
+void _location_session_set_interval(location_manager_s* handle, _location_interval_e which, int interval);
+
+void _location_event_deliver(location_manager_s* handle, const _location_event_s* event);
+_location_dispatch_s* _location_dispatch_new(location_manager_s* handle, int queue_size, location_dispatch_overflow_e overflow);
+void _location_dispatch_push(_location_dispatch_s* dispatch, const _location_event_s* event);
+bool _location_dispatch_is_current_thread(const _location_dispatch_s* dispatch);
+void _location_dispatch_destroy(_location_dispatch_s* dispatch);
+
 #ifdef __cplusplus
 }
 #endif
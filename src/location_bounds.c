@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <locations_private.h>
 #include <dlog.h>
 
@@ -43,60 +44,365 @@ static void __free_position_list(gpointer data)
 	location_position_free(position);
 }
 
-static location_bounds_type_e __convert_bounds_type(LocationBoundaryType type)
+static LocationBoundary* __create_boundary(location_bounds_s *handle)
 {
-	location_bounds_type_e ret;
-	switch(type)
+	LocationBoundary *boundary = NULL;
+	switch(handle->type)
 	{
-	case LOCATION_BOUNDARY_CIRCLE:
-		ret = LOCATION_BOUNDS_CIRCLE;
+	case LOCATION_BOUNDS_RECT:
+	{
+		LocationPosition *lt = location_position_new(0, handle->rect.top_left.latitude, handle->rect.top_left.longitude, 0, LOCATION_STATUS_2D_FIX);
+		LocationPosition *rb = location_position_new(0, handle->rect.bottom_right.latitude, handle->rect.bottom_right.longitude, 0, LOCATION_STATUS_2D_FIX);
+		if (lt && rb)
+			boundary = location_boundary_new_for_rect(lt, rb);
+		if (lt) location_position_free (lt);
+		if (rb) location_position_free (rb);
+		break;
+	}
+	case LOCATION_BOUNDS_CIRCLE:
+	{
+		LocationPosition *ct = location_position_new(0, handle->circle.center.latitude, handle->circle.center.longitude, 0, LOCATION_STATUS_2D_FIX);
+		if (ct)
+		{
+			boundary = location_boundary_new_for_circle(ct, handle->circle.radius);
+			location_position_free (ct);
+		}
 		break;
-	case LOCATION_BOUNDARY_POLYGON:
-		ret = LOCATION_BOUNDS_POLYGON;
+	}
+	case LOCATION_BOUNDS_POLYGON:
+	{
+		int i;
+		GList* position_list = NULL;
+		for(i=handle->polygon.length-1;i>=0;i--)
+		{
+			LocationPosition *position = location_position_new(0, handle->polygon.latitude[i], handle->polygon.longitude[i], 0.0, LOCATION_STATUS_2D_FIX);
+			if (!position)
+			{
+				g_list_free_full(position_list, (GDestroyNotify)__free_position_list);
+				return NULL;
+			}
+			position_list = g_list_prepend(position_list, position);
+		}
+		boundary = location_boundary_new_for_polygon(position_list);
+		g_list_free_full(position_list, (GDestroyNotify)__free_position_list);
 		break;
-	case LOCATION_BOUNDARY_NONE:
-	case LOCATION_BOUNDARY_RECT:
+	}
 	default:
-		ret = LOCATION_BOUNDS_RECT;
 		break;
 	}
-	return ret;
+	return boundary;
 }
 
-int location_bounds_create_rect(location_coords_s top_left, location_coords_s bottom_right, location_bounds_h* bounds)
+/*
+* The LocationBoundary is only needed when the bounds is handed to the location library,
+* so it is built on first use instead of at creation time.
+*/
+LocationBoundary* _location_bounds_get_boundary(location_bounds_s *bounds)
 {
-	LOCATIONS_NULL_ARG_CHECK(bounds);
-	LOCATIONS_CHECK_CONDITION(top_left.latitude>=-90 && top_left.latitude<=90,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER,"LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
-	LOCATIONS_CHECK_CONDITION(top_left.longitude>=-180 && top_left.longitude<=180,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, "LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
-	LOCATIONS_CHECK_CONDITION(bottom_right.latitude>=-90 && bottom_right.latitude<=90,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, "LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
-	LOCATIONS_CHECK_CONDITION(bottom_right.longitude>=-180 && bottom_right.longitude<=180,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, "LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+	if (bounds == NULL)
+		return NULL;
 
-	LocationPosition *lt = location_position_new(0, top_left.latitude, top_left.longitude, 0, LOCATION_STATUS_2D_FIX);
-	if (lt ==NULL)
+	if (bounds->boundary == NULL)
 	{
-		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to location_position_new", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
-		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+		bounds->boundary = __create_boundary(bounds);
+		if (bounds->boundary == NULL)
+			LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to create LocationBoundary", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
 	}
+	return bounds->boundary;
+}
 
-	LocationPosition *rb = location_position_new(0, bottom_right.latitude, bottom_right.longitude, 0, LOCATION_STATUS_2D_FIX);
-	if (rb ==NULL)
+static void __set_bbox(location_bounds_s *handle, double min_latitude, double max_latitude, double min_longitude, double max_longitude)
+{
+	handle->bbox.min_latitude = min_latitude;
+	handle->bbox.max_latitude = max_latitude;
+	handle->bbox.min_longitude = min_longitude;
+	handle->bbox.max_longitude = max_longitude;
+}
+
+static void __update_bbox(location_bounds_s *handle)
+{
+	switch(handle->type)
 	{
-		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to location_position_new", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
-		location_position_free (lt);
-		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+	case LOCATION_BOUNDS_RECT:
+	{
+		location_coords_s lt = handle->rect.top_left;
+		location_coords_s rb = handle->rect.bottom_right;
+		double min_longitude = lt.longitude;
+		double max_longitude = rb.longitude;
+		/* Do not guess how a rect crossing the 180th meridian is interpreted; only filter on latitude then. */
+		if (min_longitude > max_longitude)
+		{
+			min_longitude = -180;
+			max_longitude = 180;
+		}
+		__set_bbox(handle, MIN(lt.latitude, rb.latitude), MAX(lt.latitude, rb.latitude), min_longitude, max_longitude);
+		break;
+	}
+	case LOCATION_BOUNDS_CIRCLE:
+	{
+		/* Slightly widened with the polar radius so the box never cuts into the circle. */
+		double angle = handle->circle.radius / LOCATIONS_EARTH_RADIUS_MIN * 1.01;
+		double d_latitude = angle * 180 / M_PI;
+		double lat = handle->circle.center.latitude;
+		double lon = handle->circle.center.longitude;
+		double min_latitude = lat - d_latitude;
+		double max_latitude = lat + d_latitude;
+		if (min_latitude <= -90 || max_latitude >= 90 || angle >= M_PI / 2)
+		{
+			__set_bbox(handle, MAX(min_latitude, -90), MIN(max_latitude, 90), -180, 180);
+			break;
+		}
+		double d_longitude = asin(MIN(sin(angle) / cos(lat * M_PI / 180), 1)) * 180 / M_PI;
+		if (lon - d_longitude < -180 || lon + d_longitude > 180)
+			__set_bbox(handle, min_latitude, max_latitude, -180, 180);
+		else
+			__set_bbox(handle, min_latitude, max_latitude, lon - d_longitude, lon + d_longitude);
+		break;
+	}
+	case LOCATION_BOUNDS_POLYGON:
+	{
+		int i;
+		double min_latitude = handle->polygon.latitude[0];
+		double max_latitude = handle->polygon.latitude[0];
+		double min_longitude = handle->polygon.longitude[0];
+		double max_longitude = handle->polygon.longitude[0];
+		for(i=1;i<handle->polygon.length;i++)
+		{
+			min_latitude = MIN(min_latitude, handle->polygon.latitude[i]);
+			max_latitude = MAX(max_latitude, handle->polygon.latitude[i]);
+			min_longitude = MIN(min_longitude, handle->polygon.longitude[i]);
+			max_longitude = MAX(max_longitude, handle->polygon.longitude[i]);
+		}
+		__set_bbox(handle, min_latitude, max_latitude, min_longitude, max_longitude);
+		break;
+	}
+	default:
+		__set_bbox(handle, -90, 90, -180, 180);
+		break;
+	}
+}
+
+static inline bool __bbox_contains(const location_bounds_s *handle, double latitude, double longitude)
+{
+	return latitude >= handle->bbox.min_latitude && latitude <= handle->bbox.max_latitude
+		&& longitude >= handle->bbox.min_longitude && longitude <= handle->bbox.max_longitude;
+}
+
+/* Beyond these the flat approximation is not worth its error band; always use haversine. */
+#define LOCATIONS_CIRCLE_APPROX_MAX_ANGLE	0.05	/* radians, about 300 km */
+#define LOCATIONS_CIRCLE_APPROX_MAX_LATITUDE	80.0
+
+static void __prepare_circle(location_bounds_s *handle)
+{
+	double angle = handle->circle.radius / LOCATIONS_EARTH_RADIUS_MEAN;
+
+	handle->circle.latitude = LOCATIONS_DEG_TO_RAD(handle->circle.center.latitude);
+	handle->circle.longitude = LOCATIONS_DEG_TO_RAD(handle->circle.center.longitude);
+	handle->circle.cos_latitude = cos(handle->circle.latitude);
+	handle->circle.angle = angle;
+
+	/* The equirectangular distance uses the cosine of the center latitude for every point.
+	   Its relative error grows with the angular radius and with tan(latitude); points whose
+	   approximate distance falls within that band of the radius get the exact test. */
+	handle->circle.is_approximate = angle <= LOCATIONS_CIRCLE_APPROX_MAX_ANGLE
+		&& fabs(handle->circle.center.latitude) < LOCATIONS_CIRCLE_APPROX_MAX_LATITUDE;
+	if (handle->circle.is_approximate) {
+		double band = 2 * angle * (fabs(tan(handle->circle.latitude)) + 1) + 1e-9;
+		double inner = band < 1 ? angle * (1 - band) : 0;
+		double outer = angle * (1 + band);
+		handle->circle.inner_square = inner * inner;
+		handle->circle.outer_square = outer * outer;
+	}
+}
+
+static bool __circle_contains(const location_bounds_s *handle, double latitude, double longitude)
+{
+	double lat = LOCATIONS_DEG_TO_RAD(latitude);
+	double lon = LOCATIONS_DEG_TO_RAD(longitude);
+
+	if (handle->circle.is_approximate) {
+		double dlat = lat - handle->circle.latitude;
+		double dlon = lon - handle->circle.longitude;
+		if (dlon > M_PI)
+			dlon -= 2 * M_PI;
+		else if (dlon < -M_PI)
+			dlon += 2 * M_PI;
+		double x = dlon * handle->circle.cos_latitude;
+		double square = x * x + dlat * dlat;
+		if (square <= handle->circle.inner_square)
+			return TRUE;
+		if (square > handle->circle.outer_square)
+			return FALSE;
 	}
 
-	LocationBoundary *boundary = location_boundary_new_for_rect(lt, rb);
-	location_position_free (rb);
-	location_position_free (lt);
+	return _location_haversine_angle(handle->circle.latitude, handle->circle.longitude, handle->circle.cos_latitude,
+					 lat, lon, cos(lat)) <= handle->circle.angle;
+}
 
-	if(!boundary)
+static bool __contains(location_bounds_s *handle, LocationPosition *pos, double latitude, double longitude)
+{
+	if (!__bbox_contains(handle, latitude, longitude))
+		return FALSE;
+
+	if (handle->type == LOCATION_BOUNDS_POLYGON)
+		return _location_polygon_contains(handle, latitude, longitude);
+	if (handle->type == LOCATION_BOUNDS_CIRCLE)
+		return __circle_contains(handle, latitude, longitude);
+
+	LocationBoundary *boundary = _location_bounds_get_boundary(handle);
+	if (!boundary)
+		return FALSE;
+
+	pos->latitude = latitude;
+	pos->longitude = longitude;
+	return location_boundary_if_inside(boundary, pos)?TRUE:FALSE;
+}
+
+/* Squared distance from the origin to the segment (ax, ay) - (bx, by) */
+static double __segment_distance_square(double ax, double ay, double bx, double by)
+{
+	double dx = bx - ax;
+	double dy = by - ay;
+	double length = dx * dx + dy * dy;
+	double t = (length > 0) ? -(ax * dx + ay * dy) / length : 0;
+	t = CLAMP(t, 0, 1);
+	double x = ax + t * dx;
+	double y = ay + t * dy;
+	return x * x + y * y;
+}
+
+/* Distance (degrees of latitude) from a point to a closed ring, in the equirectangular projection around the point */
+static double __ring_distance(const double *lat, const double *lon, int length, double latitude, double longitude)
+{
+	double cos_latitude = cos(LOCATIONS_DEG_TO_RAD(latitude));
+	double best = INFINITY;
+	double px = 0, py = 0;
+	double x0 = 0, y0 = 0;
+	int i;
+
+	for (i = 0; i < length; i++) {
+		double dlon = lon[i] - longitude;
+		if (dlon > 180)
+			dlon -= 360;
+		else if (dlon < -180)
+			dlon += 360;
+		double x = dlon * cos_latitude;
+		double y = lat[i] - latitude;
+		if (i == 0) {
+			x0 = x;
+			y0 = y;
+		} else {
+			best = MIN(best, __segment_distance_square(px, py, x, y));
+		}
+		px = x;
+		py = y;
+	}
+	best = MIN(best, __segment_distance_square(px, py, x0, y0));
+	return sqrt(best);
+}
+
+double _location_bounds_get_edge_distance(const location_bounds_s *bounds, double latitude, double longitude)
+{
+	if (bounds->type == LOCATION_BOUNDS_CIRCLE) {
+		double lat = LOCATIONS_DEG_TO_RAD(latitude);
+		double angle = _location_haversine_angle(bounds->circle.latitude, bounds->circle.longitude, bounds->circle.cos_latitude,
+							 lat, LOCATIONS_DEG_TO_RAD(longitude), cos(lat));
+		return fabs(angle - bounds->circle.angle) * LOCATIONS_EARTH_RADIUS_MEAN;
+	}
+
+	double degrees;
+	if (bounds->type == LOCATION_BOUNDS_POLYGON) {
+		degrees = __ring_distance(bounds->polygon.latitude, bounds->polygon.longitude, bounds->polygon.length, latitude, longitude);
+	} else {
+		double lat[4] = { bounds->rect.top_left.latitude, bounds->rect.top_left.latitude,
+				  bounds->rect.bottom_right.latitude, bounds->rect.bottom_right.latitude };
+		double lon[4] = { bounds->rect.top_left.longitude, bounds->rect.bottom_right.longitude,
+				  bounds->rect.bottom_right.longitude, bounds->rect.top_left.longitude };
+		degrees = __ring_distance(lat, lon, 4, latitude, longitude);
+	}
+	return LOCATIONS_DEG_TO_RAD(degrees) * LOCATIONS_EARTH_RADIUS_MEAN;
+}
+
+static location_bounds_s* __new_bounds(location_bounds_type_e type)
+{
+	location_bounds_s *handle = (location_bounds_s *) malloc(sizeof(location_bounds_s));
+	if (handle == NULL)
 	{
-		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to location_boundary_new_for_rect", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
-		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+		return NULL;
 	}
+	memset(handle, 0, sizeof(location_bounds_s));
+	handle->type = type;
+	return handle;
+}
 
-	*bounds = (location_bounds_h)boundary;
+location_bounds_s* _location_bounds_clone(const location_bounds_s *bounds)
+{
+	location_bounds_s *handle = __new_bounds(bounds->type);
+	if (handle == NULL)
+		return NULL;
+
+	memcpy(handle, bounds, sizeof(location_bounds_s));
+	handle->boundary = NULL;
+	if (handle->type == LOCATION_BOUNDS_POLYGON)
+	{
+		int length = bounds->polygon.length;
+		handle->polygon.grid = NULL;
+		handle->polygon.latitude = (double *) malloc(sizeof(double) * length);
+		handle->polygon.longitude = (double *) malloc(sizeof(double) * length);
+		if (handle->polygon.latitude == NULL || handle->polygon.longitude == NULL)
+		{
+			LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to allocate vertices", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+			free(handle->polygon.latitude);
+			free(handle->polygon.longitude);
+			free(handle);
+			return NULL;
+		}
+		memcpy(handle->polygon.latitude, bounds->polygon.latitude, sizeof(double) * length);
+		memcpy(handle->polygon.longitude, bounds->polygon.longitude, sizeof(double) * length);
+	}
+	return handle;
+}
+
+bool _location_bounds_equals(const location_bounds_s *a, const location_bounds_s *b)
+{
+	if (a->type != b->type)
+		return FALSE;
+
+	switch (a->type)
+	{
+	case LOCATION_BOUNDS_RECT:
+		return a->rect.top_left.latitude == b->rect.top_left.latitude && a->rect.top_left.longitude == b->rect.top_left.longitude
+			&& a->rect.bottom_right.latitude == b->rect.bottom_right.latitude && a->rect.bottom_right.longitude == b->rect.bottom_right.longitude;
+	case LOCATION_BOUNDS_CIRCLE:
+		return a->circle.center.latitude == b->circle.center.latitude && a->circle.center.longitude == b->circle.center.longitude
+			&& a->circle.radius == b->circle.radius;
+	case LOCATION_BOUNDS_POLYGON:
+		return a->polygon.length == b->polygon.length
+			&& memcmp(a->polygon.latitude, b->polygon.latitude, sizeof(double) * a->polygon.length) == 0
+			&& memcmp(a->polygon.longitude, b->polygon.longitude, sizeof(double) * a->polygon.length) == 0;
+	default:
+		return FALSE;
+	}
+}
+
+int location_bounds_create_rect(location_coords_s top_left, location_coords_s bottom_right, location_bounds_h* bounds)
+{
+	LOCATIONS_NULL_ARG_CHECK(bounds);
+	LOCATIONS_CHECK_CONDITION(top_left.latitude>=-90 && top_left.latitude<=90,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER,"LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(top_left.longitude>=-180 && top_left.longitude<=180,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, "LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(bottom_right.latitude>=-90 && bottom_right.latitude<=90,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, "LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(bottom_right.longitude>=-180 && bottom_right.longitude<=180,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, "LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+
+	location_bounds_s *handle = __new_bounds(LOCATION_BOUNDS_RECT);
+	if (handle == NULL)
+		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+
+	handle->rect.top_left = top_left;
+	handle->rect.bottom_right = bottom_right;
+	__update_bbox(handle);
+
+	*bounds = (location_bounds_h)handle;
 	return LOCATION_BOUNDS_ERROR_NONE;
 }
 
@@ -107,23 +413,16 @@ int location_bounds_create_circle(location_coords_s center, double radius, locat
 	LOCATIONS_CHECK_CONDITION(center.latitude>=-90 && center.latitude<=90,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER,"LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
 	LOCATIONS_CHECK_CONDITION(center.longitude>=-180 && center.longitude<=180,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, "LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
 
-	LocationPosition *ct = location_position_new(0, center.latitude, center.longitude, 0, LOCATION_STATUS_2D_FIX);
-	if (ct ==NULL)
-	{
-		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to location_position_new", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+	location_bounds_s *handle = __new_bounds(LOCATION_BOUNDS_CIRCLE);
+	if (handle == NULL)
 		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
-	}
-
-	LocationBoundary *boundary = location_boundary_new_for_circle(ct,radius);
-	location_position_free (ct);
 
-	if(!boundary)
-	{
-		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to location_boundary_new_for_circle", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
-		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
-	}
+	handle->circle.center = center;
+	handle->circle.radius = radius;
+	__prepare_circle(handle);
+	__update_bbox(handle);
 
-	*bounds = (location_bounds_h)boundary;
+	*bounds = (location_bounds_h)handle;
 	return LOCATION_BOUNDS_ERROR_NONE;
 }
 
@@ -134,46 +433,40 @@ int location_bounds_create_polygon(location_coords_s* coords_list, int length, l
 	LOCATIONS_CHECK_CONDITION(length>=3,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER,"LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
 
 	int i;
-	GList* position_list = NULL;
-	LocationPosition *position = NULL;
-	bool isValid;
-	
 	for(i=0;i<length;i++)
 	{
 		if(coords_list[i].latitude < -90 || coords_list[i].latitude > 90 || coords_list[i].longitude < -180 || coords_list[i].longitude > 180)
 		{
 			LOGE("[%s] LOCATION_BOUNDS_ERROR_INVALID_PARAMETER(0x%08x)", __FUNCTION__, LOCATION_BOUNDS_ERROR_INVALID_PARAMETER);
-			isValid = FALSE;
-			break;
-		}	
-
-		position = location_position_new(0, coords_list[i].latitude, coords_list[i].longitude, 0.0, LOCATION_STATUS_2D_FIX);
-		position_list = g_list_append(position_list,position);
-		location_position_free(position);
-		isValid = TRUE;
+			return LOCATION_BOUNDS_ERROR_INVALID_PARAMETER;
+		}
 	}
 
-	if(!isValid)
-	{
-		g_list_free_full(position_list, (GDestroyNotify)__free_position_list);
-		return LOCATION_BOUNDS_ERROR_INVALID_PARAMETER;
-	}
-		
-	if (position_list ==NULL)
+	location_bounds_s *handle = __new_bounds(LOCATION_BOUNDS_POLYGON);
+	if (handle == NULL)
+		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+
+	/* Vertices are kept as two contiguous arrays so containment tests walk memory linearly. */
+	handle->polygon.latitude = (double *) malloc(sizeof(double) * length);
+	handle->polygon.longitude = (double *) malloc(sizeof(double) * length);
+	if (handle->polygon.latitude == NULL || handle->polygon.longitude == NULL)
 	{
-		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to location_position_new", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to allocate vertices", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+		free(handle->polygon.latitude);
+		free(handle->polygon.longitude);
+		free(handle);
 		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
 	}
 
-	LocationBoundary *boundary =  location_boundary_new_for_polygon(position_list);
-
-	if(!boundary)
+	for(i=0;i<length;i++)
 	{
-		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to location_boundary_new_for_rect", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
-		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+		handle->polygon.latitude[i] = coords_list[i].latitude;
+		handle->polygon.longitude[i] = coords_list[i].longitude;
 	}
+	handle->polygon.length = length;
+	__update_bbox(handle);
 
-	*bounds = (location_bounds_h)boundary;
+	*bounds = (location_bounds_h)handle;
 	return LOCATION_BOUNDS_ERROR_NONE;
 }
 
@@ -185,20 +478,80 @@ bool location_bounds_contains_coordinates(location_bounds_h bounds, location_coo
 	if (coords.latitude < -90 ||  coords.latitude > 90 || coords.longitude < -180 || coords.longitude > 180)
 		return FALSE;
 
+	location_bounds_s *handle = (location_bounds_s*)bounds;
+	if (!__bbox_contains(handle, coords.latitude, coords.longitude))
+		return FALSE;
+	if (handle->type == LOCATION_BOUNDS_POLYGON)
+		return _location_polygon_contains(handle, coords.latitude, coords.longitude);
+	if (handle->type == LOCATION_BOUNDS_CIRCLE)
+		return __circle_contains(handle, coords.latitude, coords.longitude);
+
 	LocationPosition *pos = location_position_new(0, coords.latitude, coords.longitude, 0, LOCATION_STATUS_2D_FIX);
 	if (!pos)
 		return FALSE;
-	gboolean is_inside = location_boundary_if_inside((LocationBoundary*)bounds, pos);
+	bool result = __contains(handle, pos, coords.latitude, coords.longitude);
 	location_position_free (pos);
-	bool result = is_inside?TRUE:FALSE;
 	return result;
 }
 
+int location_bounds_contains_coordinates_batch(location_bounds_h bounds, const location_coords_s *coords_list, int length, bool *contained_list)
+{
+	LOCATIONS_NULL_ARG_CHECK(bounds);
+	LOCATIONS_NULL_ARG_CHECK(coords_list);
+	LOCATIONS_NULL_ARG_CHECK(contained_list);
+	LOCATIONS_CHECK_CONDITION(length>=0,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER,"LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+
+	if (length == 0)
+		return LOCATION_BOUNDS_ERROR_NONE;
+
+	location_bounds_s *handle = (location_bounds_s*)bounds;
+
+	/* Only rect goes through the location library; a single position is reused for every coordinate. */
+	LocationPosition *pos = NULL;
+	if (handle->type == LOCATION_BOUNDS_RECT)
+	{
+		pos = location_position_new(0, 0, 0, 0, LOCATION_STATUS_2D_FIX);
+		if (!pos)
+		{
+			LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to location_position_new", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+			return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+		}
+	}
+
+	int i;
+	for(i=0;i<length;i++)
+	{
+		if (coords_list[i].latitude < -90 || coords_list[i].latitude > 90 || coords_list[i].longitude < -180 || coords_list[i].longitude > 180)
+		{
+			contained_list[i] = FALSE;
+			continue;
+		}
+		contained_list[i] = __contains(handle, pos, coords_list[i].latitude, coords_list[i].longitude);
+	}
+	if (pos)
+		location_position_free (pos);
+	return LOCATION_BOUNDS_ERROR_NONE;
+}
+
+int location_bounds_get_bounding_box(location_bounds_h bounds, location_coords_s *top_left, location_coords_s *bottom_right)
+{
+	LOCATIONS_NULL_ARG_CHECK(bounds);
+	LOCATIONS_NULL_ARG_CHECK(top_left);
+	LOCATIONS_NULL_ARG_CHECK(bottom_right);
+	location_bounds_s *handle = (location_bounds_s*)bounds;
+
+	top_left->latitude = handle->bbox.max_latitude;
+	top_left->longitude = handle->bbox.min_longitude;
+	bottom_right->latitude = handle->bbox.min_latitude;
+	bottom_right->longitude = handle->bbox.max_longitude;
+	return LOCATION_BOUNDS_ERROR_NONE;
+}
+
 int location_bounds_get_type(location_bounds_h bounds, location_bounds_type_e *type)
 {
 	LOCATIONS_NULL_ARG_CHECK(bounds);
 	LOCATIONS_NULL_ARG_CHECK(type);	
-	*type = __convert_bounds_type(((LocationBoundary*)bounds)->type);
+	*type = ((location_bounds_s*)bounds)->type;
 	return LOCATION_BOUNDS_ERROR_NONE;
 }
 
@@ -207,15 +560,15 @@ int location_bounds_get_rect_coords(location_bounds_h bounds, location_coords_s
 	LOCATIONS_NULL_ARG_CHECK(bounds);
 	LOCATIONS_NULL_ARG_CHECK(top_left);
 	LOCATIONS_NULL_ARG_CHECK(bottom_right);
-	if( __convert_bounds_type(((LocationBoundary*)bounds)->type) != LOCATION_BOUNDS_RECT)
+	location_bounds_s *handle = (location_bounds_s*)bounds;
+	if(handle->type != LOCATION_BOUNDS_RECT)
 	{
 		LOGE("[%s] LOCATION_BOUNDS_ERROR_INCORRECT_TYPE(0x%08x)", __FUNCTION__, LOCATION_BOUNDS_ERROR_INCORRECT_TYPE);
+		return LOCATION_BOUNDS_ERROR_INCORRECT_TYPE;
 	}
 
-	top_left->latitude = ((LocationBoundary*)bounds)->rect.left_top->latitude;
-	top_left->longitude = ((LocationBoundary*)bounds)->rect.left_top->longitude;
-	bottom_right->latitude =((LocationBoundary*)bounds)->rect.right_bottom->latitude;
-	bottom_right->longitude = ((LocationBoundary*)bounds)->rect.right_bottom->longitude;
+	*top_left = handle->rect.top_left;
+	*bottom_right = handle->rect.bottom_right;
 	return LOCATION_BOUNDS_ERROR_NONE;
 }
 
@@ -224,14 +577,15 @@ int location_bounds_get_circle_coords(location_bounds_h bounds, location_coords_
 	LOCATIONS_NULL_ARG_CHECK(bounds);
 	LOCATIONS_NULL_ARG_CHECK(center);
 	LOCATIONS_NULL_ARG_CHECK(radius);
-	if( __convert_bounds_type(((LocationBoundary*)bounds)->type) != LOCATION_BOUNDS_CIRCLE)
+	location_bounds_s *handle = (location_bounds_s*)bounds;
+	if(handle->type != LOCATION_BOUNDS_CIRCLE)
 	{
 		LOGE("[%s] LOCATION_BOUNDS_ERROR_INCORRECT_TYPE(0x%08x)", __FUNCTION__, LOCATION_BOUNDS_ERROR_INCORRECT_TYPE);
+		return LOCATION_BOUNDS_ERROR_INCORRECT_TYPE;
 	}
 
-	center->latitude = ((LocationBoundary*)bounds)->circle.center->latitude;
-	center->longitude =((LocationBoundary*)bounds)->circle.center->longitude;
-	*radius = ((LocationBoundary*)bounds)->circle.radius;
+	*center = handle->circle.center;
+	*radius = handle->circle.radius;
 	return LOCATION_BOUNDS_ERROR_NONE;
 }
 
@@ -239,33 +593,52 @@ int location_bounds_foreach_polygon_coords(location_bounds_h bounds, polygon_coo
 {
 	LOCATIONS_NULL_ARG_CHECK(bounds);
 	LOCATIONS_NULL_ARG_CHECK(callback);	
-	if( __convert_bounds_type(((LocationBoundary*)bounds)->type) != LOCATION_BOUNDS_POLYGON)
+	location_bounds_s *handle = (location_bounds_s*)bounds;
+	if(handle->type != LOCATION_BOUNDS_POLYGON)
 	{
 		LOGE("[%s] LOCATION_BOUNDS_ERROR_INCORRECT_TYPE(0x%08x)", __FUNCTION__, LOCATION_BOUNDS_ERROR_INCORRECT_TYPE);
+		return LOCATION_BOUNDS_ERROR_INCORRECT_TYPE;
 	}
 
-	GList *list = ((LocationBoundary*)bounds)->polygon.position_list;
-	while(list)
+	int i;
+	for(i=0;i<handle->polygon.length;i++)
 	{
-		LocationPosition *pos = list->data;
 		location_coords_s coords;
-		coords.latitude = pos->latitude;
-		coords.longitude = pos->longitude;
-		
+		coords.latitude = handle->polygon.latitude[i];
+		coords.longitude = handle->polygon.longitude[i];
+
 		if ( callback(coords, user_data) != TRUE )
 		{
 			LOGI("[%s] User quit the loop ",  __FUNCTION__);
 			break;
 		}
-		list = g_list_next(list);
 	}
 	return LOCATION_BOUNDS_ERROR_NONE;
 }
 
+int location_bounds_prepare(location_bounds_h bounds, int grid_resolution)
+{
+	LOCATIONS_NULL_ARG_CHECK(bounds);
+	LOCATIONS_CHECK_CONDITION(grid_resolution>0,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER,"LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+
+	location_bounds_s *handle = (location_bounds_s*)bounds;
+	LOCATIONS_CHECK_CONDITION(handle->type==LOCATION_BOUNDS_POLYGON,LOCATION_BOUNDS_ERROR_INCORRECT_TYPE,"LOCATION_BOUNDS_ERROR_INCORRECT_TYPE");
+
+	return _location_polygon_prepare(handle, grid_resolution);
+}
+
 int location_bounds_destroy(location_bounds_h bounds)
 {
 	LOCATIONS_NULL_ARG_CHECK(bounds);
-	location_boundary_free((LocationBoundary*)bounds);
+	location_bounds_s *handle = (location_bounds_s*)bounds;
+	if (handle->boundary)
+		location_boundary_free(handle->boundary);
+	if (handle->type == LOCATION_BOUNDS_POLYGON)
+	{
+		_location_polygon_unprepare(handle);
+		free(handle->polygon.latitude);
+		free(handle->polygon.longitude);
+	}
+	free(handle);
 	return LOCATION_BOUNDS_ERROR_NONE;
 }
-
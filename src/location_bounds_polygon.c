@@ -0,0 +1,461 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <locations_private.h>
+#include <dlog.h>
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define LOCATION_POLYGON_X86
+#include <immintrin.h>
+#endif
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_LOCATION_MANAGER"
+
+/*
+* Crossing-number kernels.
+*
+* Every kernel counts the edges (k, k+1) for k in [0, length-1) that the ray
+* going north from (latitude, longitude) crosses and returns the parity.
+* The closing edge (length-1, 0) is left to the caller.
+*
+* Instead of dividing to get the intersection latitude, both sides of the
+* comparison are multiplied by the longitude span of the edge, which is
+* non-zero for a straddling edge. All kernels use the same operations in the
+* same order so that they give the same answer, even for points on an edge.
+*/
+
+typedef unsigned int (*__crossings_func)(const double *lat, const double *lon, int length, double latitude, double longitude);
+
+static inline unsigned int __edge_crosses(double lat_a, double lon_a, double lat_b, double lon_b, double latitude, double longitude)
+{
+	if ((lon_b <= longitude) == (lon_a <= longitude))
+		return 0;
+	double span = lon_a - lon_b;
+	double rise = (lat_a - lat_b) * (longitude - lon_b);
+	double offset = (latitude - lat_b) * span;
+	return span > 0 ? offset < rise : offset > rise;
+}
+
+static unsigned int __crossings_scalar(const double *lat, const double *lon, int length, double latitude, double longitude)
+{
+	unsigned int parity = 0;
+	int k;
+	for (k = 0; k + 1 < length; k++)
+		parity ^= __edge_crosses(lat[k], lon[k], lat[k + 1], lon[k + 1], latitude, longitude);
+	return parity;
+}
+
+#ifdef LOCATION_POLYGON_X86
+
+__attribute__((target("sse2")))
+static unsigned int __crossings_sse2(const double *lat, const double *lon, int length, double latitude, double longitude)
+{
+	const __m128d x = _mm_set1_pd(longitude);
+	const __m128d y = _mm_set1_pd(latitude);
+	unsigned int parity = 0;
+	int k;
+
+	for (k = 0; k + 2 < length; k += 2) {
+		__m128d lon_a = _mm_loadu_pd(lon + k);
+		__m128d lon_b = _mm_loadu_pd(lon + k + 1);
+		__m128d lat_a = _mm_loadu_pd(lat + k);
+		__m128d lat_b = _mm_loadu_pd(lat + k + 1);
+
+		__m128d straddle = _mm_xor_pd(_mm_cmple_pd(lon_a, x), _mm_cmple_pd(lon_b, x));
+		__m128d span = _mm_sub_pd(lon_a, lon_b);
+		__m128d rise = _mm_mul_pd(_mm_sub_pd(lat_a, lat_b), _mm_sub_pd(x, lon_b));
+		__m128d offset = _mm_mul_pd(_mm_sub_pd(y, lat_b), span);
+		__m128d ascending = _mm_cmpgt_pd(span, _mm_setzero_pd());
+		__m128d below = _mm_or_pd(_mm_and_pd(ascending, _mm_cmplt_pd(offset, rise)),
+					  _mm_andnot_pd(ascending, _mm_cmpgt_pd(offset, rise)));
+		parity ^= _mm_movemask_pd(_mm_and_pd(straddle, below));
+	}
+	parity = __builtin_popcount(parity) & 1;
+
+	for (; k + 1 < length; k++)
+		parity ^= __edge_crosses(lat[k], lon[k], lat[k + 1], lon[k + 1], latitude, longitude);
+	return parity;
+}
+
+__attribute__((target("avx2")))
+static unsigned int __crossings_avx2(const double *lat, const double *lon, int length, double latitude, double longitude)
+{
+	const __m256d x = _mm256_set1_pd(longitude);
+	const __m256d y = _mm256_set1_pd(latitude);
+	unsigned int parity = 0;
+	int k;
+
+	for (k = 0; k + 4 < length; k += 4) {
+		__m256d lon_a = _mm256_loadu_pd(lon + k);
+		__m256d lon_b = _mm256_loadu_pd(lon + k + 1);
+		__m256d lat_a = _mm256_loadu_pd(lat + k);
+		__m256d lat_b = _mm256_loadu_pd(lat + k + 1);
+
+		__m256d straddle = _mm256_xor_pd(_mm256_cmp_pd(lon_a, x, _CMP_LE_OQ), _mm256_cmp_pd(lon_b, x, _CMP_LE_OQ));
+		__m256d span = _mm256_sub_pd(lon_a, lon_b);
+		__m256d rise = _mm256_mul_pd(_mm256_sub_pd(lat_a, lat_b), _mm256_sub_pd(x, lon_b));
+		__m256d offset = _mm256_mul_pd(_mm256_sub_pd(y, lat_b), span);
+		__m256d below = _mm256_blendv_pd(_mm256_cmp_pd(offset, rise, _CMP_GT_OQ), _mm256_cmp_pd(offset, rise, _CMP_LT_OQ),
+						 _mm256_cmp_pd(span, _mm256_setzero_pd(), _CMP_GT_OQ));
+		parity ^= _mm256_movemask_pd(_mm256_and_pd(straddle, below));
+	}
+	parity = __builtin_popcount(parity) & 1;
+
+	for (; k + 1 < length; k++)
+		parity ^= __edge_crosses(lat[k], lon[k], lat[k + 1], lon[k + 1], latitude, longitude);
+	return parity;
+}
+
+#endif
+
+static bool __kernel_supported(_location_polygon_kernel_e kernel)
+{
+	switch (kernel) {
+	case _LOCATION_POLYGON_KERNEL_SCALAR:
+		return TRUE;
+#ifdef LOCATION_POLYGON_X86
+	case _LOCATION_POLYGON_KERNEL_SSE2:
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("sse2");
+	case _LOCATION_POLYGON_KERNEL_AVX2:
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#endif
+	default:
+		return FALSE;
+	}
+}
+
+static __crossings_func __kernel_func(_location_polygon_kernel_e kernel)
+{
+	switch (kernel) {
+#ifdef LOCATION_POLYGON_X86
+	case _LOCATION_POLYGON_KERNEL_SSE2:
+		return __crossings_sse2;
+	case _LOCATION_POLYGON_KERNEL_AVX2:
+		return __crossings_avx2;
+#endif
+	default:
+		return __crossings_scalar;
+	}
+}
+
+static _location_polygon_kernel_e __best_kernel(void)
+{
+	if (__kernel_supported(_LOCATION_POLYGON_KERNEL_AVX2))
+		return _LOCATION_POLYGON_KERNEL_AVX2;
+	if (__kernel_supported(_LOCATION_POLYGON_KERNEL_SSE2))
+		return _LOCATION_POLYGON_KERNEL_SSE2;
+	return _LOCATION_POLYGON_KERNEL_SCALAR;
+}
+
+/* Resolved on first use. Racing first calls resolve to the same value. */
+static _location_polygon_kernel_e __kernel = _LOCATION_POLYGON_KERNEL_AUTO;
+static __crossings_func __crossings = NULL;
+
+static __crossings_func __get_crossings(void)
+{
+	if (__crossings == NULL) {
+		if (__kernel == _LOCATION_POLYGON_KERNEL_AUTO)
+			__kernel = __best_kernel();
+		__crossings = __kernel_func(__kernel);
+		LOGI("[%s] polygon kernel : %d", __FUNCTION__, __kernel);
+	}
+	return __crossings;
+}
+
+/*
+* Prepared grid.
+*
+* The inside state of a point (x, y) in a cell is derived from the state of
+* (x, top) on the top side of the cell, flipped once for every edge crossing
+* the vertical segment between them. The state of (x, top) is the state of
+* the top left corner, flipped once for every edge crossing the top side left
+* of x. Only edges touching the cell can cross either segment, so a query
+* never looks beyond its own cell.
+*
+* The grid is slightly larger than the bounding box so that the left column
+* of corners lies outside the polygon, and the corner states are propagated
+* from there along each row with the same crossing count the queries use.
+*
+* Both segments follow the rule of the kernels, a point on an edge or a vertex
+* being moved slightly north and then east, so preparing a polygon never
+* changes the answer for a point on its boundary.
+*/
+
+#define LOCATION_POLYGON_GRID_MAX_RESOLUTION	1024
+
+static inline int __grid_index(double value, double origin, double cell, int count)
+{
+	int index = (int) floor((value - origin) / cell);
+	if (index < 0)
+		return 0;
+	if (index >= count)
+		return count - 1;
+	return index;
+}
+
+static inline double __grid_row_top(const _location_polygon_grid_s *grid, int row)
+{
+	return grid->min_latitude + (row + 1) * grid->cell_latitude;
+}
+
+static inline double __grid_col_left(const _location_polygon_grid_s *grid, int col)
+{
+	return grid->min_longitude + col * grid->cell_longitude;
+}
+
+/*
+* Whether (latitude, longitude) is east of the edge (a, b), which straddles its latitude.
+* A point on the edge is moved north first, then east, as in __edge_crosses(), and the
+* comparison uses the same products so that both agree on which side of an edge a point is.
+*/
+static inline unsigned int __edge_east(double lat_a, double lon_a, double lat_b, double lon_b, double latitude, double longitude)
+{
+	double span = lon_a - lon_b;
+	double height = lat_a - lat_b;
+	double rise = height * (longitude - lon_b);
+	double offset = (latitude - lat_b) * span;
+	if (rise != offset)
+		return height > 0 ? offset < rise : offset > rise;
+	return span == 0 || (span > 0) != (height > 0);
+}
+
+/* Crossings of the horizontal segment from (top, from) to (top, to), a vertex on top being below it */
+static unsigned int __grid_cross_top(const location_bounds_s *bounds, const int *edge, int count, double top, double from, double to)
+{
+	const double *lat = bounds->polygon.latitude;
+	const double *lon = bounds->polygon.longitude;
+	int length = bounds->polygon.length;
+	unsigned int parity = 0;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		int a = edge[i];
+		int b = (a + 1 == length) ? 0 : a + 1;
+		if ((lat[a] <= top) == (lat[b] <= top))
+			continue;
+		parity ^= __edge_east(lat[a], lon[a], lat[b], lon[b], top, from) ^ __edge_east(lat[a], lon[a], lat[b], lon[b], top, to);
+	}
+	return parity;
+}
+
+/* Crossings of the vertical segment from (latitude, longitude) to (top, longitude), counted as the kernels do */
+static unsigned int __grid_cross_up(const location_bounds_s *bounds, const int *edge, int count, double latitude, double longitude, double top)
+{
+	const double *lat = bounds->polygon.latitude;
+	const double *lon = bounds->polygon.longitude;
+	int length = bounds->polygon.length;
+	unsigned int parity = 0;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		int a = edge[i];
+		int b = (a + 1 == length) ? 0 : a + 1;
+		parity ^= __edge_crosses(lat[a], lon[a], lat[b], lon[b], latitude, longitude)
+			^ __edge_crosses(lat[a], lon[a], lat[b], lon[b], top, longitude);
+	}
+	return parity;
+}
+
+/* Visits every cell the edge (a, b) may touch. Cells are widened by a small margin so that rounding never loses one. */
+static void __grid_foreach_edge_cell(const _location_polygon_grid_s *grid, const location_bounds_s *bounds, int a, int *cell_count, int *edge_list)
+{
+	const double *lat = bounds->polygon.latitude;
+	const double *lon = bounds->polygon.longitude;
+	int b = (a + 1 == bounds->polygon.length) ? 0 : a + 1;
+	double lat_margin = grid->cell_latitude * 1e-6;
+	double lon_margin = grid->cell_longitude * 1e-6;
+	double edge_min = MIN(lat[a], lat[b]);
+	double edge_max = MAX(lat[a], lat[b]);
+	int row_min = __grid_index(edge_min - lat_margin, grid->min_latitude, grid->cell_latitude, grid->rows);
+	int row_max = __grid_index(edge_max + lat_margin, grid->min_latitude, grid->cell_latitude, grid->rows);
+	int row, col;
+
+	for (row = row_min; row <= row_max; row++) {
+		double band_min = MAX(edge_min, __grid_row_top(grid, row) - grid->cell_latitude - lat_margin);
+		double band_max = MIN(edge_max, __grid_row_top(grid, row) + lat_margin);
+		double lon_min, lon_max;
+		if (lat[a] == lat[b]) {
+			lon_min = MIN(lon[a], lon[b]);
+			lon_max = MAX(lon[a], lon[b]);
+		} else {
+			double lon_1 = lon[b] + (lon[a] - lon[b]) * (band_min - lat[b]) / (lat[a] - lat[b]);
+			double lon_2 = lon[b] + (lon[a] - lon[b]) * (band_max - lat[b]) / (lat[a] - lat[b]);
+			lon_min = MIN(lon_1, lon_2);
+			lon_max = MAX(lon_1, lon_2);
+		}
+		int col_min = __grid_index(lon_min - lon_margin, grid->min_longitude, grid->cell_longitude, grid->cols);
+		int col_max = __grid_index(lon_max + lon_margin, grid->min_longitude, grid->cell_longitude, grid->cols);
+		for (col = col_min; col <= col_max; col++) {
+			int cell = row * grid->cols + col;
+			if (edge_list)
+				edge_list[cell_count[cell]++] = a;
+			else
+				cell_count[cell]++;
+		}
+	}
+}
+
+static void __grid_free(_location_polygon_grid_s *grid)
+{
+	if (grid == NULL)
+		return;
+	free(grid->cell_start);
+	free(grid->edge_list);
+	free(grid->corner);
+	free(grid);
+}
+
+static _location_polygon_grid_s* __grid_new(const location_bounds_s *bounds, int resolution)
+{
+	int cells = resolution * resolution;
+	int i, row, col;
+
+	_location_polygon_grid_s *grid = (_location_polygon_grid_s *) malloc(sizeof(_location_polygon_grid_s));
+	if (grid == NULL)
+		return NULL;
+	memset(grid, 0, sizeof(_location_polygon_grid_s));
+
+	double lat_span = bounds->bbox.max_latitude - bounds->bbox.min_latitude;
+	double lon_span = bounds->bbox.max_longitude - bounds->bbox.min_longitude;
+	double lat_margin = lat_span * 1e-6 + 1e-9;
+	double lon_margin = lon_span * 1e-6 + 1e-9;
+	grid->rows = resolution;
+	grid->cols = resolution;
+	grid->min_latitude = bounds->bbox.min_latitude - lat_margin;
+	grid->min_longitude = bounds->bbox.min_longitude - lon_margin;
+	grid->cell_latitude = (lat_span + 2 * lat_margin) / resolution;
+	grid->cell_longitude = (lon_span + 2 * lon_margin) / resolution;
+
+	/* Count edges per cell, turn the counts into offsets, then fill the buckets. */
+	grid->cell_start = (int *) calloc(cells + 1, sizeof(int));
+	grid->corner = (unsigned char *) malloc(cells);
+	if (grid->cell_start == NULL || grid->corner == NULL) {
+		__grid_free(grid);
+		return NULL;
+	}
+
+	for (i = 0; i < bounds->polygon.length; i++)
+		__grid_foreach_edge_cell(grid, bounds, i, grid->cell_start + 1, NULL);
+	for (i = 0; i < cells; i++)
+		grid->cell_start[i + 1] += grid->cell_start[i];
+
+	grid->edge_list = (int *) malloc(sizeof(int) * MAX(grid->cell_start[cells], 1));
+	int *fill = (int *) malloc(sizeof(int) * cells);
+	if (grid->edge_list == NULL || fill == NULL) {
+		free(fill);
+		__grid_free(grid);
+		return NULL;
+	}
+	memcpy(fill, grid->cell_start, sizeof(int) * cells);
+	for (i = 0; i < bounds->polygon.length; i++)
+		__grid_foreach_edge_cell(grid, bounds, i, fill, grid->edge_list);
+	free(fill);
+
+	for (row = 0; row < grid->rows; row++) {
+		double top = __grid_row_top(grid, row);
+		unsigned int parity = 0;
+		for (col = 0; col < grid->cols; col++) {
+			int cell = row * grid->cols + col;
+			grid->corner[cell] = parity;
+			parity ^= __grid_cross_top(bounds, grid->edge_list + grid->cell_start[cell], grid->cell_start[cell + 1] - grid->cell_start[cell],
+						   top, __grid_col_left(grid, col), __grid_col_left(grid, col + 1));
+		}
+	}
+	return grid;
+}
+
+static bool __grid_contains(const location_bounds_s *bounds, const _location_polygon_grid_s *grid, double latitude, double longitude)
+{
+	int row = __grid_index(latitude, grid->min_latitude, grid->cell_latitude, grid->rows);
+	int col = __grid_index(longitude, grid->min_longitude, grid->cell_longitude, grid->cols);
+	int cell = row * grid->cols + col;
+	const int *edge = grid->edge_list + grid->cell_start[cell];
+	int count = grid->cell_start[cell + 1] - grid->cell_start[cell];
+	unsigned int parity = grid->corner[cell];
+
+	if (count == 0)
+		return parity ? TRUE : FALSE;
+
+	double top = __grid_row_top(grid, row);
+	parity ^= __grid_cross_top(bounds, edge, count, top, __grid_col_left(grid, col), longitude);
+	parity ^= __grid_cross_up(bounds, edge, count, latitude, longitude, top);
+	return parity ? TRUE : FALSE;
+}
+
+bool _location_polygon_contains(const location_bounds_s *bounds, double latitude, double longitude)
+{
+	if (bounds->polygon.grid)
+		return __grid_contains(bounds, bounds->polygon.grid, latitude, longitude);
+
+	const double *lat = bounds->polygon.latitude;
+	const double *lon = bounds->polygon.longitude;
+	int last = bounds->polygon.length - 1;
+
+	unsigned int parity = __get_crossings()(lat, lon, bounds->polygon.length, latitude, longitude);
+	parity ^= __edge_crosses(lat[last], lon[last], lat[0], lon[0], latitude, longitude);
+	return parity ? TRUE : FALSE;
+}
+
+int _location_polygon_prepare(location_bounds_s *bounds, int grid_resolution)
+{
+	if (grid_resolution < 1 || grid_resolution > LOCATION_POLYGON_GRID_MAX_RESOLUTION) {
+		LOGE("[%s] LOCATION_BOUNDS_ERROR_INVALID_PARAMETER(0x%08x) : grid_resolution %d", __FUNCTION__, LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, grid_resolution);
+		return LOCATION_BOUNDS_ERROR_INVALID_PARAMETER;
+	}
+
+	_location_polygon_grid_s *grid = __grid_new(bounds, grid_resolution);
+	if (grid == NULL) {
+		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to build the grid", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+	}
+
+	__grid_free(bounds->polygon.grid);
+	bounds->polygon.grid = grid;
+	return LOCATION_BOUNDS_ERROR_NONE;
+}
+
+void _location_polygon_unprepare(location_bounds_s *bounds)
+{
+	__grid_free(bounds->polygon.grid);
+	bounds->polygon.grid = NULL;
+}
+
+bool _location_polygon_set_kernel(_location_polygon_kernel_e kernel)
+{
+	if (kernel == _LOCATION_POLYGON_KERNEL_AUTO)
+		kernel = __best_kernel();
+	else if (!__kernel_supported(kernel))
+		return FALSE;
+
+	__kernel = kernel;
+	__crossings = __kernel_func(kernel);
+	return TRUE;
+}
+
+_location_polygon_kernel_e _location_polygon_get_kernel(void)
+{
+	__get_crossings();
+	return __kernel;
+}
@@ -0,0 +1,619 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <locations_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_LOCATION_MANAGER"
+
+/*
+* Internal Macros
+*/
+#define LOCATIONS_CHECK_CONDITION(condition,error,msg)	\
+		if(condition) {} else \
+		{ LOGE("[%s] %s(0x%08x)",__FUNCTION__, msg,error); return error;}; \
+
+#define LOCATIONS_NULL_ARG_CHECK(arg)	\
+	LOCATIONS_CHECK_CONDITION(arg != NULL,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER,"LOCATION_BOUNDS_ERROR_INVALID_PARAMETER") \
+
+/* Deep enough for any tree that fits in memory. */
+#define _LOCATION_BOUNDS_SET_MAX_DEPTH	32
+
+typedef _location_bounds_set_node_s node_s;
+
+typedef struct {
+	_location_rect_s rect;
+	void *child;
+} __entry_s;
+
+/*
+* Rectangles
+*/
+
+static inline void __rect_union(_location_rect_s *dst, const _location_rect_s *src)
+{
+	dst->min_latitude = MIN(dst->min_latitude, src->min_latitude);
+	dst->max_latitude = MAX(dst->max_latitude, src->max_latitude);
+	dst->min_longitude = MIN(dst->min_longitude, src->min_longitude);
+	dst->max_longitude = MAX(dst->max_longitude, src->max_longitude);
+}
+
+static inline double __rect_area(const _location_rect_s *rect)
+{
+	return (rect->max_latitude - rect->min_latitude) * (rect->max_longitude - rect->min_longitude);
+}
+
+static inline double __rect_enlargement(const _location_rect_s *rect, const _location_rect_s *add)
+{
+	_location_rect_s merged = *rect;
+	__rect_union(&merged, add);
+	return __rect_area(&merged) - __rect_area(rect);
+}
+
+static inline bool __rect_contains_point(const _location_rect_s *rect, double latitude, double longitude)
+{
+	return latitude >= rect->min_latitude && latitude <= rect->max_latitude
+		&& longitude >= rect->min_longitude && longitude <= rect->max_longitude;
+}
+
+static inline bool __rect_contains_rect(const _location_rect_s *outer, const _location_rect_s *inner)
+{
+	return inner->min_latitude >= outer->min_latitude && inner->max_latitude <= outer->max_latitude
+		&& inner->min_longitude >= outer->min_longitude && inner->max_longitude <= outer->max_longitude;
+}
+
+/*
+* Nodes
+*/
+
+static node_s* __node_new(bool is_leaf)
+{
+	node_s *node = (node_s *) malloc(sizeof(node_s));
+	if (node == NULL)
+		return NULL;
+	memset(node, 0, sizeof(node_s));
+	node->is_leaf = is_leaf;
+	return node;
+}
+
+static void __node_free(node_s *node)
+{
+	int i;
+	if (!node->is_leaf) {
+		for (i = 0; i < node->count; i++)
+			__node_free((node_s *) node->child[i]);
+	}
+	free(node);
+}
+
+static _location_rect_s __node_rect(const node_s *node)
+{
+	int i;
+	_location_rect_s rect = node->rect[0];
+	for (i = 1; i < node->count; i++)
+		__rect_union(&rect, &node->rect[i]);
+	return rect;
+}
+
+static void __node_append(node_s *node, const _location_rect_s *rect, void *child)
+{
+	node->rect[node->count] = *rect;
+	node->child[node->count] = child;
+	if (!node->is_leaf)
+		((node_s *) child)->parent = node;
+	node->count++;
+}
+
+static void __node_remove_at(node_s *node, int index)
+{
+	node->count--;
+	node->rect[index] = node->rect[node->count];
+	node->child[index] = node->child[node->count];
+}
+
+static int __node_index_in_parent(const node_s *node)
+{
+	int i;
+	for (i = 0; i < node->parent->count; i++) {
+		if (node->parent->child[i] == node)
+			return i;
+	}
+	return -1;
+}
+
+/* Quadratic split (Guttman): moves part of the entries of an overflowing node into sibling.
+   Only called on nodes holding _LOCATION_BOUNDS_SET_NODE_MAX + 1 entries. */
+static void __node_split(node_s *node, node_s *sibling)
+{
+	__entry_s entries[_LOCATION_BOUNDS_SET_NODE_MAX + 1];
+	const int total = _LOCATION_BOUNDS_SET_NODE_MAX + 1;
+	int i, j;
+
+	for (i = 0; i < total; i++) {
+		entries[i].rect = node->rect[i];
+		entries[i].child = node->child[i];
+	}
+
+	int seed_a = 0;
+	int seed_b = 1;
+	double worst = -1;
+	for (i = 0; i < total; i++) {
+		for (j = i + 1; j < total; j++) {
+			_location_rect_s merged = entries[i].rect;
+			__rect_union(&merged, &entries[j].rect);
+			double waste = __rect_area(&merged) - __rect_area(&entries[i].rect) - __rect_area(&entries[j].rect);
+			if (waste > worst) {
+				worst = waste;
+				seed_a = i;
+				seed_b = j;
+			}
+		}
+	}
+
+	sibling->is_leaf = node->is_leaf;
+	sibling->count = 0;
+	node->count = 0;
+	__node_append(node, &entries[seed_a].rect, entries[seed_a].child);
+	__node_append(sibling, &entries[seed_b].rect, entries[seed_b].child);
+	_location_rect_s rect_a = entries[seed_a].rect;
+	_location_rect_s rect_b = entries[seed_b].rect;
+
+	int remaining = total - 2;
+	for (i = 0; i < total; i++) {
+		if (i == seed_a || i == seed_b)
+			continue;
+
+		node_s *target;
+		if (node->count + remaining <= _LOCATION_BOUNDS_SET_NODE_MIN) {
+			target = node;
+		} else if (sibling->count + remaining <= _LOCATION_BOUNDS_SET_NODE_MIN) {
+			target = sibling;
+		} else {
+			double grow_a = __rect_enlargement(&rect_a, &entries[i].rect);
+			double grow_b = __rect_enlargement(&rect_b, &entries[i].rect);
+			if (grow_a < grow_b || (grow_a == grow_b && node->count <= sibling->count))
+				target = node;
+			else
+				target = sibling;
+		}
+
+		__node_append(target, &entries[i].rect, entries[i].child);
+		__rect_union(target == node ? &rect_a : &rect_b, &entries[i].rect);
+		remaining--;
+	}
+}
+
+/*
+* Tree operations
+*/
+
+static node_s* __choose_leaf(node_s *node, const _location_rect_s *rect)
+{
+	while (!node->is_leaf) {
+		int i;
+		int best = 0;
+		double best_grow = __rect_enlargement(&node->rect[0], rect);
+		double best_area = __rect_area(&node->rect[0]);
+		for (i = 1; i < node->count; i++) {
+			double grow = __rect_enlargement(&node->rect[i], rect);
+			double area = __rect_area(&node->rect[i]);
+			if (grow < best_grow || (grow == best_grow && area < best_area)) {
+				best = i;
+				best_grow = grow;
+				best_area = area;
+			}
+		}
+		node = (node_s *) node->child[best];
+	}
+	return node;
+}
+
+static int __insert(location_bounds_set_s *handle, location_bounds_s *bounds)
+{
+	node_s *leaf = __choose_leaf(handle->root, &bounds->bbox);
+
+	/* Reserve every node a split can need up front, so a failed allocation leaves the tree untouched. */
+	node_s *spare[_LOCATION_BOUNDS_SET_MAX_DEPTH + 1];
+	int needed = 0;
+	node_s *node = leaf;
+	while (node && node->count == _LOCATION_BOUNDS_SET_NODE_MAX) {
+		needed += node->parent ? 1 : 2;
+		node = node->parent;
+	}
+	int i;
+	for (i = 0; i < needed; i++) {
+		spare[i] = __node_new(FALSE);
+		if (spare[i] == NULL) {
+			while (i-- > 0)
+				free(spare[i]);
+			LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+			return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+		}
+	}
+
+	__node_append(leaf, &bounds->bbox, bounds);
+
+	node = leaf;
+	node_s *split = NULL;
+	if (node->count > _LOCATION_BOUNDS_SET_NODE_MAX) {
+		split = spare[--needed];
+		__node_split(node, split);
+	}
+
+	while (node->parent) {
+		node_s *parent = node->parent;
+		parent->rect[__node_index_in_parent(node)] = __node_rect(node);
+		if (split) {
+			_location_rect_s rect = __node_rect(split);
+			__node_append(parent, &rect, split);
+			split = NULL;
+			if (parent->count > _LOCATION_BOUNDS_SET_NODE_MAX) {
+				split = spare[--needed];
+				__node_split(parent, split);
+			}
+		}
+		node = parent;
+	}
+
+	if (split) {
+		node_s *root = spare[--needed];
+		root->is_leaf = FALSE;
+		root->count = 0;
+		_location_rect_s rect = __node_rect(node);
+		__node_append(root, &rect, node);
+		rect = __node_rect(split);
+		__node_append(root, &rect, split);
+		handle->root = root;
+	}
+	handle->count++;
+	return LOCATION_BOUNDS_ERROR_NONE;
+}
+
+static bool __find_leaf(node_s *node, location_bounds_s *bounds, node_s **leaf, int *index)
+{
+	int i;
+	for (i = 0; i < node->count; i++) {
+		if (node->is_leaf) {
+			if (node->child[i] == bounds) {
+				*leaf = node;
+				*index = i;
+				return TRUE;
+			}
+		} else if (__rect_contains_rect(&node->rect[i], &bounds->bbox)) {
+			if (__find_leaf((node_s *) node->child[i], bounds, leaf, index))
+				return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+static void __collect_entries(node_s *node, GList **orphans)
+{
+	int i;
+	for (i = 0; i < node->count; i++) {
+		if (node->is_leaf)
+			*orphans = g_list_prepend(*orphans, node->child[i]);
+		else
+			__collect_entries((node_s *) node->child[i], orphans);
+	}
+}
+
+static void __remove(location_bounds_set_s *handle, node_s *leaf, int index)
+{
+	GList *orphans = NULL;
+	node_s *node = leaf;
+
+	__node_remove_at(node, index);
+
+	/* Condense: dissolve underfull nodes and re-insert what they held. */
+	while (node->parent) {
+		node_s *parent = node->parent;
+		int position = __node_index_in_parent(node);
+		if (node->count < _LOCATION_BOUNDS_SET_NODE_MIN) {
+			__node_remove_at(parent, position);
+			__collect_entries(node, &orphans);
+			__node_free(node);
+		} else {
+			parent->rect[position] = __node_rect(node);
+		}
+		node = parent;
+	}
+
+	while (!handle->root->is_leaf && handle->root->count == 1) {
+		node_s *root = (node_s *) handle->root->child[0];
+		free(handle->root);
+		root->parent = NULL;
+		handle->root = root;
+	}
+	if (!handle->root->is_leaf && handle->root->count == 0)
+		handle->root->is_leaf = TRUE;
+
+	handle->count--;
+
+	/* The orphans are still counted, __insert() counts them again */
+	while (orphans) {
+		GList *link = orphans;
+		orphans = g_list_remove_link(orphans, link);
+		handle->count--;
+		if (__insert(handle, (location_bounds_s *) link->data) == LOCATION_BOUNDS_ERROR_NONE) {
+			g_list_free_1(link);
+		} else {
+			/* Kept out of the tree until memory allows, but still in the set */
+			LOGE("[%s] Failed to re-insert bounds %p, keeping it pending", __FUNCTION__, link->data);
+			handle->count++;
+			handle->pending = g_list_concat(link, handle->pending);
+		}
+	}
+}
+
+static void __insert_pending(location_bounds_set_s *handle)
+{
+	while (handle->pending) {
+		GList *link = handle->pending;
+		handle->count--;
+		if (__insert(handle, (location_bounds_s *) link->data) != LOCATION_BOUNDS_ERROR_NONE) {
+			handle->count++;
+			return;
+		}
+		handle->pending = g_list_delete_link(handle->pending, link);
+	}
+}
+
+static bool __search(node_s *node, location_coords_s coords, location_bounds_set_cb callback, void *user_data)
+{
+	int i;
+	for (i = 0; i < node->count; i++) {
+		if (!__rect_contains_point(&node->rect[i], coords.latitude, coords.longitude))
+			continue;
+
+		if (node->is_leaf) {
+			if (location_bounds_contains_coordinates((location_bounds_h) node->child[i], coords)
+			    && callback((location_bounds_h) node->child[i], user_data) != TRUE)
+				return FALSE;
+		} else if (!__search((node_s *) node->child[i], coords, callback, user_data)) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+static bool __search_pending(GList *pending, location_coords_s coords, location_bounds_set_cb callback, void *user_data)
+{
+	for (; pending; pending = g_list_next(pending)) {
+		location_bounds_s *bounds = (location_bounds_s *) pending->data;
+		if (__rect_contains_point(&bounds->bbox, coords.latitude, coords.longitude)
+		    && location_bounds_contains_coordinates((location_bounds_h) bounds, coords)
+		    && callback((location_bounds_h) bounds, user_data) != TRUE)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+/*
+* Sort-Tile-Recursive bulk loading
+*/
+
+static int __compare_center_longitude(const void *a, const void *b)
+{
+	const _location_rect_s *ra = &((const __entry_s *) a)->rect;
+	const _location_rect_s *rb = &((const __entry_s *) b)->rect;
+	double ca = ra->min_longitude + ra->max_longitude;
+	double cb = rb->min_longitude + rb->max_longitude;
+	return (ca > cb) - (ca < cb);
+}
+
+static int __compare_center_latitude(const void *a, const void *b)
+{
+	const _location_rect_s *ra = &((const __entry_s *) a)->rect;
+	const _location_rect_s *rb = &((const __entry_s *) b)->rect;
+	double ca = ra->min_latitude + ra->max_latitude;
+	double cb = rb->min_latitude + rb->max_latitude;
+	return (ca > cb) - (ca < cb);
+}
+
+static node_s* __bulk_load(__entry_s *entries, int length, bool is_leaf)
+{
+	int node_count = (length + _LOCATION_BOUNDS_SET_NODE_MAX - 1) / _LOCATION_BOUNDS_SET_NODE_MAX;
+	int slice_count = (int) ceil(sqrt((double) node_count));
+	int slice_size = slice_count * _LOCATION_BOUNDS_SET_NODE_MAX;
+	int i, j;
+
+	qsort(entries, length, sizeof(__entry_s), __compare_center_longitude);
+	for (i = 0; i < length; i += slice_size)
+		qsort(entries + i, MIN(slice_size, length - i), sizeof(__entry_s), __compare_center_latitude);
+
+	__entry_s *parents = (__entry_s *) malloc(sizeof(__entry_s) * node_count);
+	if (parents == NULL)
+		return NULL;
+
+	int built = 0;
+	for (i = 0; i < length; i += _LOCATION_BOUNDS_SET_NODE_MAX) {
+		node_s *node = __node_new(is_leaf);
+		if (node == NULL) {
+			for (j = 0; j < built; j++)
+				free(parents[j].child);
+			free(parents);
+			return NULL;
+		}
+		for (j = i; j < MIN(i + _LOCATION_BOUNDS_SET_NODE_MAX, length); j++)
+			__node_append(node, &entries[j].rect, entries[j].child);
+		parents[built].rect = __node_rect(node);
+		parents[built].child = node;
+		built++;
+	}
+
+	node_s *root;
+	if (built == 1)
+		root = (node_s *) parents[0].child;
+	else
+		root = __bulk_load(parents, built, FALSE);
+
+	/* Each level releases only the nodes it allocated itself. */
+	if (root == NULL) {
+		for (j = 0; j < built; j++)
+			free(parents[j].child);
+	}
+	free(parents);
+	return root;
+}
+
+/*
+* Public Implementation
+*/
+
+int location_bounds_set_create(location_bounds_set_h *set)
+{
+	LOCATIONS_NULL_ARG_CHECK(set);
+
+	location_bounds_set_s *handle = (location_bounds_set_s *) malloc(sizeof(location_bounds_set_s));
+	if (handle == NULL) {
+		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+	}
+	memset(handle, 0, sizeof(location_bounds_set_s));
+
+	handle->root = __node_new(TRUE);
+	if (handle->root == NULL) {
+		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+		free(handle);
+		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+	}
+
+	*set = (location_bounds_set_h) handle;
+	return LOCATION_BOUNDS_ERROR_NONE;
+}
+
+int location_bounds_set_create_from_list(const location_bounds_h *bounds_list, int length, location_bounds_set_h *set)
+{
+	LOCATIONS_NULL_ARG_CHECK(set);
+	LOCATIONS_CHECK_CONDITION(length>=0,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER,"LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(length==0 || bounds_list!=NULL,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER,"LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+
+	int i;
+	for (i = 0; i < length; i++)
+		LOCATIONS_NULL_ARG_CHECK(bounds_list[i]);
+
+	if (length == 0)
+		return location_bounds_set_create(set);
+
+	location_bounds_set_s *handle = (location_bounds_set_s *) malloc(sizeof(location_bounds_set_s));
+	__entry_s *entries = (__entry_s *) malloc(sizeof(__entry_s) * length);
+	if (handle == NULL || entries == NULL) {
+		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+		free(handle);
+		free(entries);
+		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+	}
+
+	for (i = 0; i < length; i++) {
+		entries[i].rect = ((location_bounds_s *) bounds_list[i])->bbox;
+		entries[i].child = bounds_list[i];
+	}
+
+	handle->root = __bulk_load(entries, length, TRUE);
+	free(entries);
+	if (handle->root == NULL) {
+		LOGE("[%s] LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to build the index", __FUNCTION__, LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY);
+		free(handle);
+		return LOCATION_BOUNDS_ERROR_OUT_OF_MEMORY;
+	}
+	handle->root->parent = NULL;
+	handle->count = length;
+	handle->pending = NULL;
+
+	*set = (location_bounds_set_h) handle;
+	return LOCATION_BOUNDS_ERROR_NONE;
+}
+
+int location_bounds_set_add(location_bounds_set_h set, location_bounds_h bounds)
+{
+	LOCATIONS_NULL_ARG_CHECK(set);
+	LOCATIONS_NULL_ARG_CHECK(bounds);
+	location_bounds_set_s *handle = (location_bounds_set_s *) set;
+
+	__insert_pending(handle);
+	node_s *leaf;
+	int index;
+	if (__find_leaf(handle->root, (location_bounds_s *) bounds, &leaf, &index) || g_list_find(handle->pending, bounds)) {
+		LOGE("[%s] LOCATION_BOUNDS_ERROR_INVALID_PARAMETER(0x%08x) : bounds is already in the set", __FUNCTION__, LOCATION_BOUNDS_ERROR_INVALID_PARAMETER);
+		return LOCATION_BOUNDS_ERROR_INVALID_PARAMETER;
+	}
+
+	return __insert(handle, (location_bounds_s *) bounds);
+}
+
+int location_bounds_set_remove(location_bounds_set_h set, location_bounds_h bounds)
+{
+	LOCATIONS_NULL_ARG_CHECK(set);
+	LOCATIONS_NULL_ARG_CHECK(bounds);
+	location_bounds_set_s *handle = (location_bounds_set_s *) set;
+
+	GList *link = g_list_find(handle->pending, bounds);
+	if (link) {
+		handle->pending = g_list_delete_link(handle->pending, link);
+		handle->count--;
+		return LOCATION_BOUNDS_ERROR_NONE;
+	}
+	__insert_pending(handle);
+
+	node_s *leaf;
+	int index;
+	if (!__find_leaf(handle->root, (location_bounds_s *) bounds, &leaf, &index)) {
+		LOGE("[%s] LOCATION_BOUNDS_ERROR_INVALID_PARAMETER(0x%08x) : bounds is not in the set", __FUNCTION__, LOCATION_BOUNDS_ERROR_INVALID_PARAMETER);
+		return LOCATION_BOUNDS_ERROR_INVALID_PARAMETER;
+	}
+
+	__remove(handle, leaf, index);
+	return LOCATION_BOUNDS_ERROR_NONE;
+}
+
+int location_bounds_set_get_count(location_bounds_set_h set, int *count)
+{
+	LOCATIONS_NULL_ARG_CHECK(set);
+	LOCATIONS_NULL_ARG_CHECK(count);
+	*count = ((location_bounds_set_s *) set)->count;
+	return LOCATION_BOUNDS_ERROR_NONE;
+}
+
+int location_bounds_set_foreach_containing_bounds(location_bounds_set_h set, location_coords_s coords, location_bounds_set_cb callback, void *user_data)
+{
+	LOCATIONS_NULL_ARG_CHECK(set);
+	LOCATIONS_NULL_ARG_CHECK(callback);
+	LOCATIONS_CHECK_CONDITION(coords.latitude>=-90 && coords.latitude<=90,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER,"LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(coords.longitude>=-180 && coords.longitude<=180,LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, "LOCATION_BOUNDS_ERROR_INVALID_PARAMETER");
+
+	location_bounds_set_s *handle = (location_bounds_set_s *) set;
+	if (!__search(handle->root, coords, callback, user_data) || !__search_pending(handle->pending, coords, callback, user_data))
+		LOGI("[%s] User quit the loop ",  __FUNCTION__);
+	return LOCATION_BOUNDS_ERROR_NONE;
+}
+
+int location_bounds_set_destroy(location_bounds_set_h set)
+{
+	LOCATIONS_NULL_ARG_CHECK(set);
+	location_bounds_set_s *handle = (location_bounds_set_s *) set;
+	__node_free(handle->root);
+	g_list_free(handle->pending);
+	free(handle);
+	return LOCATION_BOUNDS_ERROR_NONE;
+}
@@ -0,0 +1,216 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locations_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_LOCATION_MANAGER"
+
+static void __slot_write(_location_dispatch_slot_s *slot, const _location_event_s *event)
+{
+	__atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	memcpy(&slot->event, event, sizeof(_location_event_s));
+	__atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELEASE);
+}
+
+static unsigned int __slot_read(_location_dispatch_slot_s *slot, _location_event_s *event)
+{
+	unsigned int seq;
+	do {
+		while ((seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE)) & 1)
+			;
+		memcpy(event, &slot->event, sizeof(_location_event_s));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq);
+	return seq;
+}
+
+static bool __pop(_location_dispatch_s *dispatch, _location_event_s *event)
+{
+	for (;;) {
+		unsigned int tail = __atomic_load_n(&dispatch->tail, __ATOMIC_ACQUIRE);
+		if (tail == __atomic_load_n(&dispatch->head, __ATOMIC_ACQUIRE))
+			return FALSE;
+		memcpy(event, &dispatch->events[tail & dispatch->mask], sizeof(_location_event_s));
+		/* Fails if the producer dropped this event meanwhile, the copy may then be torn */
+		if (__atomic_compare_exchange_n(&dispatch->tail, &tail, tail + 1, FALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+			return TRUE;
+	}
+}
+
+static bool __has_work(_location_dispatch_s *dispatch)
+{
+	if (__atomic_load_n(&dispatch->tail, __ATOMIC_SEQ_CST) != __atomic_load_n(&dispatch->head, __ATOMIC_SEQ_CST))
+		return TRUE;
+	if (dispatch->overflow == LOCATIONS_DISPATCH_OVERFLOW_COALESCE) {
+		int i;
+		for (i = 0; i < _LOCATIONS_EVENT_TYPE_NUM; i++) {
+			if (__atomic_load_n(&dispatch->slots[i].is_pending, __ATOMIC_SEQ_CST))
+				return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+static void __drain(_location_dispatch_s *dispatch)
+{
+	_location_event_s event;
+	while (__pop(dispatch, &event))
+		_location_event_deliver(dispatch->handle, &event);
+
+	if (dispatch->overflow != LOCATIONS_DISPATCH_OVERFLOW_COALESCE)
+		return;
+
+	/* Coalesced events are newer than anything in the ring when they were stored */
+	int i;
+	for (i = 0; i < _LOCATIONS_EVENT_TYPE_NUM; i++) {
+		_location_dispatch_slot_s *slot = &dispatch->slots[i];
+		if (!__atomic_exchange_n(&slot->is_pending, 0, __ATOMIC_SEQ_CST))
+			continue;
+		unsigned int seq = __slot_read(slot, &event);
+		/* A write racing with the exchange above is read here and flagged again, deliver it once */
+		if (seq == slot->delivered_seq)
+			continue;
+		/* Every write adds 2 to seq, the writes since the last delivery other than this one were replaced.
+		   Counted here, as the producer cannot tell whether the event it overwrites was already read. */
+		unsigned int replaced = (seq - slot->delivered_seq) / 2 - 1;
+		if (replaced)
+			__atomic_add_fetch(&dispatch->handle->dispatch_coalesced, replaced, __ATOMIC_RELAXED);
+		slot->delivered_seq = seq;
+		_location_event_deliver(dispatch->handle, &event);
+	}
+}
+
+static void* __dispatch_thread(void *user_data)
+{
+	_location_dispatch_s *dispatch = (_location_dispatch_s *) user_data;
+	for (;;) {
+		__drain(dispatch);
+
+		pthread_mutex_lock(&dispatch->lock);
+		__atomic_store_n(&dispatch->is_waiting, 1, __ATOMIC_SEQ_CST);
+		bool is_quit = __atomic_load_n(&dispatch->is_quit, __ATOMIC_SEQ_CST);
+		if (!__has_work(dispatch) && !is_quit)
+			pthread_cond_wait(&dispatch->cond, &dispatch->lock);
+		__atomic_store_n(&dispatch->is_waiting, 0, __ATOMIC_SEQ_CST);
+		pthread_mutex_unlock(&dispatch->lock);
+
+		if (is_quit && !__has_work(dispatch))
+			break;
+	}
+	return NULL;
+}
+
+static void __wake(_location_dispatch_s *dispatch)
+{
+	/* Pairs with the store of is_waiting before the dispatch thread checks for work */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&dispatch->is_waiting, __ATOMIC_SEQ_CST)) {
+		pthread_mutex_lock(&dispatch->lock);
+		pthread_cond_signal(&dispatch->cond);
+		pthread_mutex_unlock(&dispatch->lock);
+	}
+}
+
+_location_dispatch_s* _location_dispatch_new(location_manager_s *handle, int queue_size, location_dispatch_overflow_e overflow)
+{
+	_location_dispatch_s *dispatch = (_location_dispatch_s *) malloc(sizeof(_location_dispatch_s));
+	if (dispatch == NULL)
+		return NULL;
+	memset(dispatch, 0, sizeof(_location_dispatch_s));
+
+	unsigned int capacity = 1;
+	while (capacity < (unsigned int) queue_size)
+		capacity <<= 1;
+	dispatch->events = (_location_event_s *) malloc(sizeof(_location_event_s) * capacity);
+	if (dispatch->events == NULL) {
+		free(dispatch);
+		return NULL;
+	}
+	dispatch->mask = capacity - 1;
+	dispatch->handle = handle;
+	dispatch->overflow = overflow;
+	pthread_mutex_init(&dispatch->lock, NULL);
+	pthread_cond_init(&dispatch->cond, NULL);
+
+	if (pthread_create(&dispatch->thread, NULL, __dispatch_thread, dispatch) != 0) {
+		LOGE("[%s] fail to create the dispatch thread", __FUNCTION__);
+		pthread_cond_destroy(&dispatch->cond);
+		pthread_mutex_destroy(&dispatch->lock);
+		free(dispatch->events);
+		free(dispatch);
+		return NULL;
+	}
+	return dispatch;
+}
+
+void _location_dispatch_push(_location_dispatch_s *dispatch, const _location_event_s *event)
+{
+	location_manager_s *handle = dispatch->handle;
+	unsigned int head = dispatch->head;
+
+	if (dispatch->overflow == LOCATIONS_DISPATCH_OVERFLOW_COALESCE) {
+		_location_dispatch_slot_s *slot = &dispatch->slots[event->type];
+		/* Once an event of this type overflowed, newer ones replace it until it is delivered */
+		if (__atomic_load_n(&slot->is_pending, __ATOMIC_SEQ_CST)
+		    || head - __atomic_load_n(&dispatch->tail, __ATOMIC_ACQUIRE) > dispatch->mask) {
+			__slot_write(slot, event);
+			__atomic_store_n(&slot->is_pending, 1, __ATOMIC_SEQ_CST);
+			__wake(dispatch);
+			return;
+		}
+	} else {
+		unsigned int tail = __atomic_load_n(&dispatch->tail, __ATOMIC_ACQUIRE);
+		while (head - tail > dispatch->mask) {
+			/* Full: drop the oldest, unless the dispatch thread just took it */
+			if (__atomic_compare_exchange_n(&dispatch->tail, &tail, tail + 1, FALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+				__atomic_add_fetch(&handle->dispatch_dropped, 1, __ATOMIC_RELAXED);
+				tail++;
+			}
+		}
+	}
+
+	memcpy(&dispatch->events[head & dispatch->mask], event, sizeof(_location_event_s));
+	__atomic_store_n(&dispatch->head, head + 1, __ATOMIC_RELEASE);
+	__wake(dispatch);
+}
+
+bool _location_dispatch_is_current_thread(const _location_dispatch_s *dispatch)
+{
+	return pthread_equal(pthread_self(), dispatch->thread);
+}
+
+void _location_dispatch_destroy(_location_dispatch_s *dispatch)
+{
+	/* The dispatch thread delivers what is still queued before it exits */
+	__atomic_store_n(&dispatch->is_quit, 1, __ATOMIC_SEQ_CST);
+	pthread_mutex_lock(&dispatch->lock);
+	pthread_cond_signal(&dispatch->cond);
+	pthread_mutex_unlock(&dispatch->lock);
+	pthread_join(dispatch->thread, NULL);
+
+	pthread_cond_destroy(&dispatch->cond);
+	pthread_mutex_destroy(&dispatch->lock);
+	free(dispatch->events);
+	free(dispatch);
+}
@@ -0,0 +1,89 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <locations_private.h>
+
+/*
+* Adaptive interval of the duty cycle. Each policy has a distance the device may travel between
+* two fixes; the interval is that distance over the observed speed, within the bounds of the manager.
+* The interval drops at once when the device speeds up and at most doubles from one fix to the next,
+* so a short stop does not leave the track sparse when the device moves again.
+*/
+
+#define _LOCATION_DUTY_CYCLE_STATIONARY_SPEED	0.5	/* meters per second, slower is stationary */
+#define _LOCATION_DUTY_CYCLE_OFF_INTERVAL	30	/* seconds, from which the backend is stopped between fixes */
+#define _LOCATION_DUTY_CYCLE_WARM_UP	10	/* seconds the backend is started before the fix is due */
+
+static const double target_distances[] = {
+	[LOCATIONS_DUTY_CYCLE_HIGH_ACCURACY] = 10.0,
+	[LOCATIONS_DUTY_CYCLE_BALANCED] = 50.0,
+	[LOCATIONS_DUTY_CYCLE_POWER_SAVING] = 200.0,
+};
+
+void _location_duty_cycle_reset(_location_duty_cycle_s *duty, location_duty_cycle_policy_e policy, int min_interval, int max_interval)
+{
+	duty->policy = policy;
+	duty->min_interval = min_interval;
+	duty->max_interval = max_interval;
+	__atomic_store_n(&duty->interval, min_interval, __ATOMIC_RELAXED);
+	duty->has_anchor = FALSE;
+}
+
+/* Speed from the displacement since the last good fix, less what the accuracy of the fix explains */
+static double __displacement_speed(const _location_duty_cycle_s *duty, double latitude, double longitude, double accuracy, long long now)
+{
+	if (!duty->has_anchor || now <= duty->anchor_ns)
+		return -1;
+	double x = (longitude - duty->anchor_longitude) * cos((latitude + duty->anchor_latitude) / 2);
+	double y = latitude - duty->anchor_latitude;
+	double distance = sqrt(x * x + y * y) * LOCATIONS_EARTH_RADIUS_MEAN - accuracy;
+	return distance > 0 ? distance / ((now - duty->anchor_ns) / 1e9) : 0;
+}
+
+int _location_duty_cycle_update(_location_duty_cycle_s *duty, const location_fix_s *fix, double speed, long long now)
+{
+	double distance = target_distances[duty->policy];
+	/* Keep the backend on at the shortest interval until a fix is good enough to plan from */
+	if (fix->status == LOCATIONS_FIX_NONE || fix->horizontal_accuracy <= 0 || fix->horizontal_accuracy > 2 * distance) {
+		__atomic_store_n(&duty->interval, duty->min_interval, __ATOMIC_RELAXED);
+		return 0;
+	}
+
+	double latitude = LOCATIONS_DEG_TO_RAD(fix->latitude);
+	double longitude = LOCATIONS_DEG_TO_RAD(fix->longitude);
+	double moved = __displacement_speed(duty, latitude, longitude, fix->horizontal_accuracy, now);
+	if (moved > speed)
+		speed = moved;
+	duty->has_anchor = TRUE;
+	duty->anchor_latitude = latitude;
+	duty->anchor_longitude = longitude;
+	duty->anchor_ns = now;
+
+	int interval;
+	if (speed < 0)
+		interval = duty->min_interval;
+	else if (speed < _LOCATION_DUTY_CYCLE_STATIONARY_SPEED)
+		interval = duty->max_interval;
+	else
+		interval = distance / speed < duty->max_interval ? (int) (distance / speed) : duty->max_interval;
+	if (interval > 2 * duty->interval)
+		interval = 2 * duty->interval;
+	if (interval < duty->min_interval)
+		interval = duty->min_interval;
+	__atomic_store_n(&duty->interval, interval, __ATOMIC_RELAXED);
+
+	return interval >= _LOCATION_DUTY_CYCLE_OFF_INTERVAL ? interval - _LOCATION_DUTY_CYCLE_WARM_UP : 0;
+}
@@ -0,0 +1,229 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locations_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_LOCATION_MANAGER"
+
+static _location_geofence_engine_s* __engine_new(void)
+{
+	_location_geofence_engine_s *engine = (_location_geofence_engine_s *) malloc(sizeof(_location_geofence_engine_s));
+	if (engine == NULL)
+		return NULL;
+	memset(engine, 0, sizeof(_location_geofence_engine_s));
+
+	if (location_bounds_set_create(&engine->set) != LOCATION_BOUNDS_ERROR_NONE) {
+		free(engine);
+		return NULL;
+	}
+	engine->fences = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, free);
+	engine->inside = g_ptr_array_new();
+	return engine;
+}
+
+static _location_geofence_engine_s* __engine_get(location_manager_s *handle)
+{
+	if (handle->geofence == NULL) {
+		handle->geofence = __engine_new();
+		if (handle->geofence == NULL)
+			LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+	}
+	return handle->geofence;
+}
+
+static void __inside_remove(_location_geofence_engine_s *engine, _location_geofence_s *fence)
+{
+	int last = engine->inside->len - 1;
+	if (fence->inside_index != last) {
+		_location_geofence_s *moved = (_location_geofence_s *) g_ptr_array_index(engine->inside, last);
+		moved->inside_index = fence->inside_index;
+	}
+	g_ptr_array_remove_index_fast(engine->inside, fence->inside_index);
+	fence->is_inside = FALSE;
+	fence->inside_index = -1;
+}
+
+static void __inside_add(_location_geofence_engine_s *engine, _location_geofence_s *fence, time_t timestamp)
+{
+	fence->is_inside = TRUE;
+	fence->is_dwell_reported = FALSE;
+	fence->enter_time = timestamp;
+	fence->inside_index = engine->inside->len;
+	g_ptr_array_add(engine->inside, fence);
+}
+
+static bool __event_push(_location_geofence_engine_s *engine, location_bounds_s *bounds, location_geofence_event_e event)
+{
+	if (engine->event_count == engine->event_capacity) {
+		int capacity = engine->event_capacity ? engine->event_capacity * 2 : 16;
+		_location_geofence_event_s *events = (_location_geofence_event_s *) realloc(engine->events, sizeof(_location_geofence_event_s) * capacity);
+		if (events == NULL) {
+			LOGE("[%s] OUT_OF_MEMORY(0x%08x) : geofence event dropped", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+			return FALSE;
+		}
+		engine->events = events;
+		engine->event_capacity = capacity;
+	}
+	engine->events[engine->event_count].bounds = bounds;
+	engine->events[engine->event_count].event = event;
+	engine->event_count++;
+	return TRUE;
+}
+
+static bool __found_cb(location_bounds_h bounds, void *user_data)
+{
+	_location_geofence_engine_s *engine = (_location_geofence_engine_s *) user_data;
+	_location_geofence_s *fence = (_location_geofence_s *) g_hash_table_lookup(engine->fences, bounds);
+	if (fence == NULL)
+		return TRUE;
+
+	fence->found_stamp = engine->stamp;
+	if (!fence->is_inside) {
+		if (engine->margin > 0
+		    && _location_bounds_get_edge_distance(fence->bounds, engine->fix->latitude, engine->fix->longitude) < engine->margin)
+			return TRUE;
+		__inside_add(engine, fence, engine->fix->timestamp);
+		__event_push(engine, fence->bounds, LOCATIONS_GEOFENCE_ENTER);
+	}
+	return TRUE;
+}
+
+int _location_geofence_add(location_manager_s *handle, location_bounds_s *bounds)
+{
+	_location_geofence_engine_s *engine = __engine_get(handle);
+	if (engine == NULL)
+		return LOCATIONS_ERROR_OUT_OF_MEMORY;
+
+	if (g_hash_table_lookup(engine->fences, bounds)) {
+		LOGE("[%s] LOCATIONS_ERROR_INVALID_PARAMETER(0x%08x) : already added", __FUNCTION__, LOCATIONS_ERROR_INVALID_PARAMETER);
+		return LOCATIONS_ERROR_INVALID_PARAMETER;
+	}
+
+	_location_geofence_s *fence = (_location_geofence_s *) malloc(sizeof(_location_geofence_s));
+	if (fence == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+		return LOCATIONS_ERROR_OUT_OF_MEMORY;
+	}
+	memset(fence, 0, sizeof(_location_geofence_s));
+	fence->bounds = bounds;
+	fence->inside_index = -1;
+
+	if (location_bounds_set_add(engine->set, (location_bounds_h) bounds) != LOCATION_BOUNDS_ERROR_NONE) {
+		free(fence);
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+		return LOCATIONS_ERROR_OUT_OF_MEMORY;
+	}
+	g_hash_table_insert(engine->fences, bounds, fence);
+	return LOCATIONS_ERROR_NONE;
+}
+
+int _location_geofence_remove(location_manager_s *handle, location_bounds_s *bounds)
+{
+	_location_geofence_engine_s *engine = handle->geofence;
+	_location_geofence_s *fence = engine ? (_location_geofence_s *) g_hash_table_lookup(engine->fences, bounds) : NULL;
+	if (fence == NULL) {
+		LOGE("[%s] LOCATIONS_ERROR_INVALID_PARAMETER(0x%08x) : not added", __FUNCTION__, LOCATIONS_ERROR_INVALID_PARAMETER);
+		return LOCATIONS_ERROR_INVALID_PARAMETER;
+	}
+
+	if (fence->is_inside)
+		__inside_remove(engine, fence);
+	location_bounds_set_remove(engine->set, (location_bounds_h) bounds);
+	g_hash_table_remove(engine->fences, bounds);
+	return LOCATIONS_ERROR_NONE;
+}
+
+int _location_geofence_reset(location_manager_s *handle, double buffer, int dwell_time)
+{
+	_location_geofence_engine_s *engine = __engine_get(handle);
+	if (engine == NULL)
+		return LOCATIONS_ERROR_OUT_OF_MEMORY;
+
+	while (engine->inside->len > 0)
+		__inside_remove(engine, (_location_geofence_s *) g_ptr_array_index(engine->inside, engine->inside->len - 1));
+	engine->buffer = buffer;
+	engine->dwell_time = dwell_time;
+	return LOCATIONS_ERROR_NONE;
+}
+
+void _location_geofence_update(location_manager_s *handle, const location_fix_s *fix)
+{
+	_location_geofence_engine_s *engine = handle->geofence;
+	if (engine == NULL || fix->status == LOCATIONS_FIX_NONE || !handle->user_cb[_LOCATIONS_EVENT_TYPE_GEOFENCE])
+		return;
+
+	location_coords_s coords;
+	coords.latitude = fix->latitude;
+	coords.longitude = fix->longitude;
+	if (coords.latitude < -90 || coords.latitude > 90 || coords.longitude < -180 || coords.longitude > 180)
+		return;
+
+	/* The same margin both ways, so that a fix cannot enter a fence its accuracy might put outside */
+	engine->stamp++;
+	engine->fix = fix;
+	engine->margin = engine->buffer + (fix->horizontal_accuracy > 0 ? fix->horizontal_accuracy : 0);
+	engine->event_count = 0;
+	location_bounds_set_foreach_containing_bounds(engine->set, coords, __found_cb, engine);
+
+	/* Backwards, so that a removal only moves a fence that was already checked */
+	int i;
+	for (i = (int) engine->inside->len - 1; i >= 0; i--) {
+		_location_geofence_s *fence = (_location_geofence_s *) g_ptr_array_index(engine->inside, i);
+		if (fence->found_stamp != engine->stamp) {
+			if (engine->margin > 0 && _location_bounds_get_edge_distance(fence->bounds, fix->latitude, fix->longitude) < engine->margin)
+				continue;
+			__inside_remove(engine, fence);
+			__event_push(engine, fence->bounds, LOCATIONS_GEOFENCE_EXIT);
+		} else if (engine->dwell_time > 0 && !fence->is_dwell_reported && fix->timestamp - fence->enter_time >= engine->dwell_time) {
+			fence->is_dwell_reported = TRUE;
+			__event_push(engine, fence->bounds, LOCATIONS_GEOFENCE_DWELL);
+		}
+	}
+	engine->fix = NULL;
+
+	/* The callback may add or remove geofences, so it only runs once the state is consistent.
+	   The events of a fence removed by an earlier callback are dropped, its bounds may be destroyed. */
+	int count = engine->event_count;
+	for (i = 0; i < count && handle->user_cb[_LOCATIONS_EVENT_TYPE_GEOFENCE]; i++) {
+		if (g_hash_table_lookup(engine->fences, engine->events[i].bounds) == NULL)
+			continue;
+		LOGI("[%s] Geofence event %d", __FUNCTION__, engine->events[i].event);
+		((location_geofence_event_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_GEOFENCE]) ((location_bounds_h) engine->events[i].bounds,
+											engine->events[i].event, fix,
+											handle->user_data[_LOCATIONS_EVENT_TYPE_GEOFENCE]);
+	}
+}
+
+void _location_geofence_destroy(location_manager_s *handle)
+{
+	_location_geofence_engine_s *engine = handle->geofence;
+	if (engine == NULL)
+		return;
+
+	location_bounds_set_destroy(engine->set);
+	g_hash_table_destroy(engine->fences);
+	g_ptr_array_free(engine->inside, TRUE);
+	free(engine->events);
+	free(engine);
+	handle->geofence = NULL;
+}
@@ -0,0 +1,218 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <string.h>
+#include <locations_private.h>
+
+/*
+* Constant velocity Kalman filter in a local east/north/up plane.
+* Every axis has the state (position, velocity) and the same motion model. The measurements are
+* axis aligned and the east and north noises are equal, so east and north share one covariance
+* and the filter runs as three independent 2x2 filters, two of them with a single covariance update.
+*/
+
+#define _LOCATION_KALMAN_DEFAULT_ACCURACY	50.0	/* meters, for fixes without accuracy */
+#define _LOCATION_KALMAN_VELOCITY_NOISE	1.0	/* meters per second */
+#define _LOCATION_KALMAN_INITIAL_VELOCITY_NOISE	10.0	/* meters per second */
+#define _LOCATION_KALMAN_MAX_OFFSET	10000.0	/* meters from the plane origin before it is moved */
+
+static void __init_axis(double *covariance, double noise)
+{
+	covariance[0] = noise * noise;
+	covariance[1] = 0;
+	covariance[2] = _LOCATION_KALMAN_INITIAL_VELOCITY_NOISE * _LOCATION_KALMAN_INITIAL_VELOCITY_NOISE;
+}
+
+/* P = F P F' + Q with F = [1 dt; 0 1] and a white acceleration of the given deviation */
+static void __predict_covariance(double *covariance, double dt, double acceleration)
+{
+	double q = acceleration * acceleration;
+	double dt2 = dt * dt;
+	covariance[0] += 2 * covariance[1] * dt + covariance[2] * dt2 + q * dt2 * dt2 / 4;
+	covariance[1] += covariance[2] * dt + q * dt2 * dt / 2;
+	covariance[2] += q * dt2;
+}
+
+/* Position measurement: returns the gains and updates P = (I - K H) P with H = [1 0] */
+static void __update_position_covariance(double *covariance, double noise, double *gain_position, double *gain_velocity)
+{
+	double s = covariance[0] + noise * noise;
+	*gain_position = covariance[0] / s;
+	*gain_velocity = covariance[1] / s;
+	covariance[2] -= *gain_velocity * covariance[1];
+	covariance[1] *= 1 - *gain_position;
+	covariance[0] *= 1 - *gain_position;
+}
+
+/* Velocity measurement, H = [0 1] */
+static void __update_velocity_covariance(double *covariance, double noise, double *gain_position, double *gain_velocity)
+{
+	double s = covariance[2] + noise * noise;
+	*gain_position = covariance[1] / s;
+	*gain_velocity = covariance[2] / s;
+	covariance[0] -= *gain_position * covariance[1];
+	covariance[1] *= 1 - *gain_velocity;
+	covariance[2] *= 1 - *gain_velocity;
+}
+
+static void __to_plane(const _location_kalman_s *filter, double latitude, double longitude, double *east, double *north)
+{
+	double dlon = longitude - filter->origin_longitude;
+	if (dlon > 180)
+		dlon -= 360;
+	else if (dlon < -180)
+		dlon += 360;
+	*east = LOCATIONS_DEG_TO_RAD(dlon) * filter->origin_cos_latitude * LOCATIONS_EARTH_RADIUS_MEAN;
+	*north = LOCATIONS_DEG_TO_RAD(latitude - filter->origin_latitude) * LOCATIONS_EARTH_RADIUS_MEAN;
+}
+
+static void __from_plane(const _location_kalman_s *filter, double east, double north, double *latitude, double *longitude)
+{
+	*latitude = filter->origin_latitude + north / LOCATIONS_EARTH_RADIUS_MEAN * 180 / M_PI;
+	*latitude = CLAMP(*latitude, -90, 90);
+	*longitude = filter->origin_longitude;
+	if (filter->origin_cos_latitude > 1e-9)
+		*longitude += east / (LOCATIONS_EARTH_RADIUS_MEAN * filter->origin_cos_latitude) * 180 / M_PI;
+	if (*longitude > 180)
+		*longitude -= 360;
+	else if (*longitude < -180)
+		*longitude += 360;
+}
+
+static void __set_origin(_location_kalman_s *filter, double latitude, double longitude)
+{
+	filter->origin_latitude = latitude;
+	filter->origin_longitude = longitude;
+	filter->origin_cos_latitude = cos(LOCATIONS_DEG_TO_RAD(latitude));
+}
+
+static void __predict(_location_kalman_s *filter, gint64 now)
+{
+	double dt = (now - filter->time) / 1000000.0;
+	filter->time = now;
+	if (dt <= 0)
+		return;
+
+	filter->east += filter->velocity_east * dt;
+	filter->north += filter->velocity_north * dt;
+	filter->up += filter->velocity_up * dt;
+	__predict_covariance(filter->horizontal, dt, filter->acceleration);
+	__predict_covariance(filter->vertical, dt, filter->acceleration);
+}
+
+void _location_kalman_reset(_location_kalman_s *filter, double acceleration)
+{
+	memset(filter, 0, sizeof(_location_kalman_s));
+	filter->acceleration = acceleration;
+}
+
+void _location_kalman_update_position(_location_kalman_s *filter, const location_fix_s *fix, gint64 now)
+{
+	if (fix->status == LOCATIONS_FIX_NONE)
+		return;
+
+	double noise = fix->horizontal_accuracy > 0 ? fix->horizontal_accuracy : _LOCATION_KALMAN_DEFAULT_ACCURACY;
+	double vertical_noise = fix->vertical_accuracy > 0 ? fix->vertical_accuracy : 2 * noise;
+	bool has_altitude = fix->status == LOCATIONS_FIX_3D;
+
+	if (!filter->is_initialized) {
+		__set_origin(filter, fix->latitude, fix->longitude);
+		filter->time = now;
+		__init_axis(filter->horizontal, noise);
+		__init_axis(filter->vertical, vertical_noise);
+		filter->up = has_altitude ? fix->altitude : 0;
+		filter->has_altitude = has_altitude;
+		filter->is_initialized = TRUE;
+		return;
+	}
+
+	__predict(filter, now);
+
+	double east, north, k_position, k_velocity;
+	__to_plane(filter, fix->latitude, fix->longitude, &east, &north);
+	__update_position_covariance(filter->horizontal, noise, &k_position, &k_velocity);
+	filter->velocity_east += k_velocity * (east - filter->east);
+	filter->velocity_north += k_velocity * (north - filter->north);
+	filter->east += k_position * (east - filter->east);
+	filter->north += k_position * (north - filter->north);
+
+	if (has_altitude) {
+		if (!filter->has_altitude) {
+			__init_axis(filter->vertical, vertical_noise);
+			filter->up = fix->altitude;
+			filter->velocity_up = 0;
+			filter->has_altitude = TRUE;
+		} else {
+			__update_position_covariance(filter->vertical, vertical_noise, &k_position, &k_velocity);
+			filter->velocity_up += k_velocity * (fix->altitude - filter->up);
+			filter->up += k_position * (fix->altitude - filter->up);
+		}
+	}
+
+	/* Keep the plane small so the projection stays accurate */
+	if (fabs(filter->east) > _LOCATION_KALMAN_MAX_OFFSET || fabs(filter->north) > _LOCATION_KALMAN_MAX_OFFSET) {
+		double latitude, longitude;
+		__from_plane(filter, filter->east, filter->north, &latitude, &longitude);
+		__set_origin(filter, latitude, longitude);
+		filter->east = 0;
+		filter->north = 0;
+	}
+}
+
+void _location_kalman_update_velocity(_location_kalman_s *filter, double speed, double direction, double climb, gint64 now)
+{
+	if (!filter->is_initialized)
+		return;
+
+	__predict(filter, now);
+
+	/* speed and climb are in km/h, direction in degrees from the north */
+	double v = speed / 3.6;
+	double heading = LOCATIONS_DEG_TO_RAD(direction);
+	double k_position, k_velocity;
+	__update_velocity_covariance(filter->horizontal, _LOCATION_KALMAN_VELOCITY_NOISE, &k_position, &k_velocity);
+	double d_east = v * sin(heading) - filter->velocity_east;
+	double d_north = v * cos(heading) - filter->velocity_north;
+	filter->east += k_position * d_east;
+	filter->north += k_position * d_north;
+	filter->velocity_east += k_velocity * d_east;
+	filter->velocity_north += k_velocity * d_north;
+
+	if (filter->has_altitude) {
+		__update_velocity_covariance(filter->vertical, _LOCATION_KALMAN_VELOCITY_NOISE, &k_position, &k_velocity);
+		double d_up = climb / 3.6 - filter->velocity_up;
+		filter->up += k_position * d_up;
+		filter->velocity_up += k_velocity * d_up;
+	}
+}
+
+void _location_kalman_get_fix(const _location_kalman_s *filter, location_fix_s *fix)
+{
+	__from_plane(filter, filter->east, filter->north, &fix->latitude, &fix->longitude);
+	if (filter->has_altitude)
+		fix->altitude = filter->up;
+	fix->horizontal_accuracy = sqrt(filter->horizontal[0]);
+	if (filter->has_altitude)
+		fix->vertical_accuracy = sqrt(filter->vertical[0]);
+
+	double speed = sqrt(filter->velocity_east * filter->velocity_east + filter->velocity_north * filter->velocity_north);
+	fix->speed = speed * 3.6;
+	if (speed > 0) {
+		double direction = atan2(filter->velocity_east, filter->velocity_north) * 180 / M_PI;
+		fix->direction = direction < 0 ? direction + 360 : direction;
+	}
+	fix->climb = filter->velocity_up * 3.6;
+}
@@ -0,0 +1,145 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locations_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_LOCATION_MANAGER"
+
+/*
+* The listener arrays are read without a lock from the signal handlers and the dispatch thread.
+* A writer publishes a new array and keeps the old one until it sees no reader at all, readers
+* only announce themselves with a counter. A writer running inside a callback never waits.
+*/
+
+static _location_listener_array_s* __array_new(int count)
+{
+	_location_listener_array_s *array = (_location_listener_array_s *) malloc(sizeof(_location_listener_array_s) + sizeof(_location_listener_s) * count);
+	if (array)
+		array->count = count;
+	return array;
+}
+
+static void __retired_free(location_manager_s *handle)
+{
+	if (handle->retired_listeners == NULL)
+		return;
+	guint i;
+	for (i = 0; i < handle->retired_listeners->len; i++)
+		free(g_ptr_array_index(handle->retired_listeners, i));
+	g_ptr_array_set_size(handle->retired_listeners, 0);
+}
+
+/* Called with listener_lock held */
+static void __publish(location_manager_s *handle, _location_event_e type, _location_listener_array_s *array)
+{
+	_location_listener_array_s *old = handle->listeners[type];
+	__atomic_store_n(&handle->listeners[type], array, __ATOMIC_SEQ_CST);
+	if (old) {
+		if (handle->retired_listeners == NULL)
+			handle->retired_listeners = g_ptr_array_new();
+		g_ptr_array_add(handle->retired_listeners, old);
+	}
+	/* A reader that comes after this load can only see the new arrays */
+	if (__atomic_load_n(&handle->listener_readers, __ATOMIC_SEQ_CST) == 0)
+		__retired_free(handle);
+}
+
+int _location_listener_add(location_manager_s *handle, _location_event_e type, const void *cb, void *user_data, int *id)
+{
+	pthread_mutex_lock(&handle->listener_lock);
+	_location_listener_array_s *old = handle->listeners[type];
+	int count = old ? old->count : 0;
+	_location_listener_array_s *array = __array_new(count + 1);
+	if (array == NULL) {
+		pthread_mutex_unlock(&handle->listener_lock);
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+		return LOCATIONS_ERROR_OUT_OF_MEMORY;
+	}
+	if (count)
+		memcpy(array->listeners, old->listeners, sizeof(_location_listener_s) * count);
+	array->listeners[count].id = ++handle->next_listener_id;
+	array->listeners[count].cb = cb;
+	array->listeners[count].user_data = user_data;
+	*id = array->listeners[count].id;
+	__publish(handle, type, array);
+	pthread_mutex_unlock(&handle->listener_lock);
+	return LOCATIONS_ERROR_NONE;
+}
+
+int _location_listener_remove(location_manager_s *handle, int id)
+{
+	pthread_mutex_lock(&handle->listener_lock);
+	int type, i;
+	for (type = 0; type < _LOCATIONS_EVENT_TYPE_NUM; type++) {
+		_location_listener_array_s *old = handle->listeners[type];
+		if (old == NULL)
+			continue;
+		for (i = 0; i < old->count && old->listeners[i].id != id; i++)
+			;
+		if (i == old->count)
+			continue;
+
+		_location_listener_array_s *array = NULL;
+		if (old->count > 1) {
+			array = __array_new(old->count - 1);
+			if (array == NULL) {
+				pthread_mutex_unlock(&handle->listener_lock);
+				LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+				return LOCATIONS_ERROR_OUT_OF_MEMORY;
+			}
+			/* Keep the registration order */
+			memcpy(array->listeners, old->listeners, sizeof(_location_listener_s) * i);
+			memcpy(array->listeners + i, old->listeners + i + 1, sizeof(_location_listener_s) * (old->count - i - 1));
+		}
+		__publish(handle, type, array);
+		pthread_mutex_unlock(&handle->listener_lock);
+		return LOCATIONS_ERROR_NONE;
+	}
+	pthread_mutex_unlock(&handle->listener_lock);
+	LOGE("[%s] LOCATIONS_ERROR_INVALID_PARAMETER(0x%08x) : unknown listener %d", __FUNCTION__, LOCATIONS_ERROR_INVALID_PARAMETER, id);
+	return LOCATIONS_ERROR_INVALID_PARAMETER;
+}
+
+const _location_listener_array_s* _location_listeners_acquire(location_manager_s *handle, _location_event_e type)
+{
+	__atomic_add_fetch(&handle->listener_readers, 1, __ATOMIC_SEQ_CST);
+	return __atomic_load_n(&handle->listeners[type], __ATOMIC_SEQ_CST);
+}
+
+void _location_listeners_release(location_manager_s *handle)
+{
+	__atomic_sub_fetch(&handle->listener_readers, 1, __ATOMIC_SEQ_CST);
+}
+
+void _location_listeners_destroy(location_manager_s *handle)
+{
+	int type;
+	for (type = 0; type < _LOCATIONS_EVENT_TYPE_NUM; type++) {
+		free(handle->listeners[type]);
+		handle->listeners[type] = NULL;
+	}
+	__retired_free(handle);
+	if (handle->retired_listeners)
+		g_ptr_array_free(handle->retired_listeners, TRUE);
+	handle->retired_listeners = NULL;
+}
@@ -0,0 +1,353 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locations_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_LOCATION_MANAGER"
+
+/*
+* Internal Macros
+*/
+#define LOCATIONS_CHECK_CONDITION(condition,error,msg)	\
+		if(condition) {} else \
+		{ LOGE("[%s] %s(0x%08x)",__FUNCTION__, msg,error); return error;}; \
+
+#define LOCATIONS_NULL_ARG_CHECK(arg)	\
+	LOCATIONS_CHECK_CONDITION(arg != NULL,LOCATIONS_ERROR_INVALID_PARAMETER,"LOCATIONS_ERROR_INVALID_PARAMETER") \
+
+/* GSV has the most fields: 4 satellites of 4 fields after 4, and the signal of NMEA 4.1 */
+#define _LOCATION_NMEA_FIELD_MAX	24
+
+/*
+* Sentences are decoded where they lie, in the fed data when they are complete in one chunk,
+* fields are ranges of the sentence and numbers are read from them without copying.
+*/
+
+typedef struct {
+	const char *text;
+	int length;
+} __field_s;
+
+typedef struct {
+	__field_s fields[_LOCATION_NMEA_FIELD_MAX];
+	int count;
+} __sentence_s;
+
+static const __field_s empty_field = { "", 0 };
+
+static inline const __field_s* __get(const __sentence_s *sentence, int index)
+{
+	return index < sentence->count ? &sentence->fields[index] : &empty_field;
+}
+
+static inline char __get_char(const __sentence_s *sentence, int index)
+{
+	const __field_s *field = __get(sentence, index);
+	return field->length ? field->text[0] : '\0';
+}
+
+/* Decimal number without exponent, the decimal point does not depend on the locale like with strtod() */
+static double __parse_double(const __field_s *field)
+{
+	const char *c = field->text, *end = field->text + field->length;
+	bool is_negative = (c < end && *c == '-');
+	if (c < end && (*c == '-' || *c == '+'))
+		c++;
+	double value = 0, scale = 1;
+	for (; c < end && *c >= '0' && *c <= '9'; c++)
+		value = value * 10 + (*c - '0');
+	if (c < end && *c == '.') {
+		for (c++; c < end && *c >= '0' && *c <= '9'; c++) {
+			value = value * 10 + (*c - '0');
+			scale *= 10;
+		}
+	}
+	return is_negative ? -value / scale : value / scale;
+}
+
+static int __parse_int(const __field_s *field)
+{
+	return (int) __parse_double(field);
+}
+
+/* ddmm.mmmm or dddmm.mmmm and its hemisphere */
+static double __parse_coordinate(const __field_s *value, const __field_s *hemisphere)
+{
+	double minutes = __parse_double(value);
+	int degrees = (int) (minutes / 100);
+	double coordinate = degrees + (minutes - degrees * 100) / 60;
+	if (hemisphere->length && (hemisphere->text[0] == 'S' || hemisphere->text[0] == 'W'))
+		coordinate = -coordinate;
+	return coordinate;
+}
+
+/* hhmmss.sss */
+static double __parse_time(const __field_s *field)
+{
+	double value = __parse_double(field);
+	int hours = (int) (value / 10000);
+	int minutes = (int) (value / 100) % 100;
+	return hours * 3600 + minutes * 60 + (value - hours * 10000 - minutes * 100);
+}
+
+static void __parse_gga(const __sentence_s *sentence, location_nmea_gga_s *gga)
+{
+	gga->utc_time = __parse_time(__get(sentence, 1));
+	gga->latitude = __parse_coordinate(__get(sentence, 2), __get(sentence, 3));
+	gga->longitude = __parse_coordinate(__get(sentence, 4), __get(sentence, 5));
+	gga->quality = __parse_int(__get(sentence, 6));
+	gga->num_of_sat_used = __parse_int(__get(sentence, 7));
+	gga->hdop = __parse_double(__get(sentence, 8));
+	gga->altitude = __parse_double(__get(sentence, 9));
+	gga->geoid_separation = __parse_double(__get(sentence, 11));
+}
+
+static void __parse_rmc(const __sentence_s *sentence, location_nmea_rmc_s *rmc)
+{
+	rmc->utc_time = __parse_time(__get(sentence, 1));
+	rmc->is_valid = (__get_char(sentence, 2) == 'A');
+	rmc->latitude = __parse_coordinate(__get(sentence, 3), __get(sentence, 4));
+	rmc->longitude = __parse_coordinate(__get(sentence, 5), __get(sentence, 6));
+	rmc->speed = __parse_double(__get(sentence, 7)) * 1.852;
+	rmc->direction = __parse_double(__get(sentence, 8));
+	if (__get(sentence, 9)->length) {
+		int date = __parse_int(__get(sentence, 9));
+		rmc->day = date / 10000;
+		rmc->month = date / 100 % 100;
+		rmc->year = date % 100 + (date % 100 < 80 ? 2000 : 1900);
+	}
+}
+
+static void __parse_gsa(const __sentence_s *sentence, location_nmea_gsa_s *gsa)
+{
+	gsa->is_automatic = (__get_char(sentence, 1) == 'A');
+	gsa->fix_type = __parse_int(__get(sentence, 2));
+	int i;
+	for (i = 3; i < 15; i++) {
+		if (__get(sentence, i)->length)
+			gsa->prn[gsa->num_of_prn++] = __parse_int(__get(sentence, i));
+	}
+	gsa->pdop = __parse_double(__get(sentence, 15));
+	gsa->hdop = __parse_double(__get(sentence, 16));
+	gsa->vdop = __parse_double(__get(sentence, 17));
+}
+
+static void __parse_gsv(const __sentence_s *sentence, location_nmea_gsv_s *gsv)
+{
+	gsv->num_of_messages = __parse_int(__get(sentence, 1));
+	gsv->message_number = __parse_int(__get(sentence, 2));
+	gsv->num_of_inview = __parse_int(__get(sentence, 3));
+	int i;
+	for (i = 4; i + 3 < sentence->count && gsv->num_of_satellites < 4; i += 4) {
+		/* Receivers pad the last message of a cycle with empty blocks */
+		if (__get(sentence, i)->length == 0)
+			continue;
+		location_nmea_satellite_s *satellite = &gsv->satellites[gsv->num_of_satellites++];
+		satellite->prn = __parse_int(__get(sentence, i));
+		satellite->elevation = __parse_int(__get(sentence, i + 1));
+		satellite->azimuth = __parse_int(__get(sentence, i + 2));
+		satellite->snr = __get(sentence, i + 3)->length ? __parse_int(__get(sentence, i + 3)) : -1;
+	}
+}
+
+static void __parse_vtg(const __sentence_s *sentence, location_nmea_vtg_s *vtg)
+{
+	vtg->direction = __parse_double(__get(sentence, 1));
+	vtg->magnetic_direction = __parse_double(__get(sentence, 3));
+	vtg->speed = __parse_double(__get(sentence, 7));
+}
+
+static int __hex_digit(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+/* text is a whole sentence from its '$', through its checksum if it has one */
+static void __decode(location_nmea_parser_s *handle, const char *text, int length)
+{
+	const char *body = text + 1;
+	int body_length = length - 1;
+	if (length >= 4 && text[length - 3] == '*') {
+		body_length = length - 4;
+		unsigned char sum = 0;
+		int i;
+		for (i = 0; i < body_length; i++)
+			sum ^= (unsigned char) body[i];
+		int high = __hex_digit(text[length - 2]), low = __hex_digit(text[length - 1]);
+		if (high < 0 || low < 0 || sum != high * 16 + low) {
+			handle->error_count++;
+			return;
+		}
+	}
+
+	__sentence_s sentence;
+	const char *c = body, *end = body + body_length;
+	sentence.count = 0;
+	while (sentence.count < _LOCATION_NMEA_FIELD_MAX) {
+		const char *comma = memchr(c, ',', end - c);
+		__field_s *field = &sentence.fields[sentence.count++];
+		field->text = c;
+		field->length = (comma ? comma : end) - c;
+		if (comma == NULL)
+			break;
+		c = comma + 1;
+	}
+
+	/* Talker and sentence, the proprietary sentences ($P...) are not decoded */
+	const __field_s *address = &sentence.fields[0];
+	if (address->length != 5 || address->text[0] == 'P')
+		return;
+
+	location_nmea_record_s record;
+	memset(&record, 0, sizeof(location_nmea_record_s));
+	record.talker[0] = address->text[0];
+	record.talker[1] = address->text[1];
+	const char *type = address->text + 2;
+	if (memcmp(type, "GGA", 3) == 0) {
+		record.type = LOCATIONS_NMEA_GGA;
+		__parse_gga(&sentence, &record.data.gga);
+	} else if (memcmp(type, "RMC", 3) == 0) {
+		record.type = LOCATIONS_NMEA_RMC;
+		__parse_rmc(&sentence, &record.data.rmc);
+	} else if (memcmp(type, "GSA", 3) == 0) {
+		record.type = LOCATIONS_NMEA_GSA;
+		__parse_gsa(&sentence, &record.data.gsa);
+	} else if (memcmp(type, "GSV", 3) == 0) {
+		record.type = LOCATIONS_NMEA_GSV;
+		__parse_gsv(&sentence, &record.data.gsv);
+	} else if (memcmp(type, "VTG", 3) == 0) {
+		record.type = LOCATIONS_NMEA_VTG;
+		__parse_vtg(&sentence, &record.data.vtg);
+	} else {
+		return;
+	}
+	handle->callback(&record, handle->user_data);
+}
+
+/*
+* Length of the sentence starting at text[0] == '$', 0 if it is not complete yet.
+* A negative value is the offset to resume from after a corrupted sentence: the next '$',
+* or the maximum length.
+*/
+static int __sentence_end(const char *text, int length)
+{
+	int i;
+	for (i = 1; i < length && i < LOCATION_NMEA_SENTENCE_MAX; i++) {
+		switch (text[i]) {
+		case '*':
+			if (i + 3 > LOCATION_NMEA_SENTENCE_MAX)
+				return -LOCATION_NMEA_SENTENCE_MAX;
+			return i + 2 < length ? i + 3 : 0;
+		case '\r':
+		case '\n':
+			return i;
+		case '$':
+			return -i;
+		}
+	}
+	return i == LOCATION_NMEA_SENTENCE_MAX ? -LOCATION_NMEA_SENTENCE_MAX : 0;
+}
+
+int location_nmea_parser_create(location_nmea_record_cb callback, void *user_data, location_nmea_parser_h *parser)
+{
+	LOCATIONS_NULL_ARG_CHECK(callback);
+	LOCATIONS_NULL_ARG_CHECK(parser);
+
+	location_nmea_parser_s *handle = (location_nmea_parser_s *) malloc(sizeof(location_nmea_parser_s));
+	if (handle == NULL) {
+		LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+		return LOCATIONS_ERROR_OUT_OF_MEMORY;
+	}
+	memset(handle, 0, sizeof(location_nmea_parser_s));
+	handle->callback = callback;
+	handle->user_data = user_data;
+	*parser = (location_nmea_parser_h) handle;
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_nmea_parser_destroy(location_nmea_parser_h parser)
+{
+	LOCATIONS_NULL_ARG_CHECK(parser);
+	free(parser);
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_nmea_parser_feed(location_nmea_parser_h parser, const char *data, int length)
+{
+	LOCATIONS_NULL_ARG_CHECK(parser);
+	LOCATIONS_NULL_ARG_CHECK(data);
+	LOCATIONS_CHECK_CONDITION(length >= 0, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	location_nmea_parser_s *handle = (location_nmea_parser_s *) parser;
+
+	int i = 0;
+	while (i < length) {
+		const char *text;
+		int text_length, pending = handle->length;
+		if (pending) {
+			/* Complete the sentence cut by the previous chunk */
+			int count = MIN(length - i, LOCATION_NMEA_SENTENCE_MAX - pending);
+			memcpy(handle->sentence + pending, data + i, count);
+			text = handle->sentence;
+			text_length = pending + count;
+		} else {
+			const char *start = (const char *) memchr(data + i, '$', length - i);
+			if (start == NULL)
+				break;
+			i = start - data;
+			text = start;
+			text_length = length - i;
+		}
+
+		int end = __sentence_end(text, text_length);
+		if (end == 0) {
+			/* The rest of the chunk is the beginning of a sentence, shorter than the maximum */
+			if (!pending)
+				memcpy(handle->sentence, text, text_length);
+			handle->length = text_length;
+			break;
+		}
+		handle->length = 0;
+		if (end > 0) {
+			__decode(handle, text, end);
+		} else {
+			handle->error_count++;
+			end = -end;
+		}
+		i += end - pending;
+	}
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_nmea_parser_get_error_count(location_nmea_parser_h parser, unsigned int *count)
+{
+	LOCATIONS_NULL_ARG_CHECK(parser);
+	LOCATIONS_NULL_ARG_CHECK(count);
+	*count = ((location_nmea_parser_s *) parser)->error_count;
+	return LOCATIONS_ERROR_NONE;
+}
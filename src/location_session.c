@@ -0,0 +1,333 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locations_private.h>
+#include <dlog.h>
+
+#ifdef LOG_TAG
+#undef LOG_TAG
+#endif
+#define LOG_TAG "TIZEN_N_LOCATION_MANAGER"
+
+/*
+* Backend sessions shared by the managers created with location_manager_create_shared().
+* There is at most one session per method. Its LocationObject is started while at least one of
+* its managers is started, and its signals are connected once and fanned out to those managers.
+*/
+
+static _location_session_s *sessions[LOCATIONS_METHOD_CPS + 1];
+static pthread_mutex_t session_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static const char *interval_properties[_LOCATION_INTERVAL_NUM] = { "pos-interval", "vel-interval", "sat-interval" };
+
+/* Called with session_lock held: the shortest interval requested by the managers, 0 if none */
+static int __min_interval(_location_session_s *session, _location_interval_e which)
+{
+	int i, interval = 0;
+	for (i = 0; i < (int) session->managers->len; i++) {
+		location_manager_s *handle = (location_manager_s *) g_ptr_array_index(session->managers, i);
+		if (handle->intervals[which] > 0 && (interval == 0 || handle->intervals[which] < interval))
+			interval = handle->intervals[which];
+	}
+	return interval;
+}
+
+/*
+* Copies the started managers, so that a callback may create or destroy managers meanwhile.
+* The copy is kept in the session and reused, a signal emitted from a callback gets its own.
+*/
+static int __fanout_begin(_location_session_s *session, location_manager_s ***managers)
+{
+	pthread_mutex_lock(&session_lock);
+	int i, count = 0;
+	int length = (int) session->managers->len;
+	if (session->dispatch_depth > 0) {
+		*managers = (location_manager_s **) malloc(sizeof(location_manager_s *) * length);
+	} else {
+		if (session->fanout_capacity < length) {
+			location_manager_s **fanout = (location_manager_s **) realloc(session->fanout, sizeof(location_manager_s *) * length);
+			if (fanout) {
+				session->fanout = fanout;
+				session->fanout_capacity = length;
+			}
+		}
+		*managers = (session->fanout_capacity >= length) ? session->fanout : NULL;
+	}
+	for (i = 0; *managers && i < length; i++) {
+		location_manager_s *handle = (location_manager_s *) g_ptr_array_index(session->managers, i);
+		if (handle->is_started)
+			(*managers)[count++] = handle;
+	}
+	session->dispatch_depth++;
+	pthread_mutex_unlock(&session_lock);
+	return count;
+}
+
+/* Whether the copied manager is still there and started, a previous callback may have stopped or destroyed it */
+static bool __fanout_check(_location_session_s *session, location_manager_s *handle)
+{
+	bool is_started = FALSE;
+	int i;
+	pthread_mutex_lock(&session_lock);
+	for (i = 0; i < (int) session->managers->len; i++) {
+		if (g_ptr_array_index(session->managers, i) == handle) {
+			is_started = handle->is_started;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&session_lock);
+	return is_started;
+}
+
+/* The outermost fan-out frees the managers destroyed by the callbacks, and the session if none is left */
+static void __fanout_end(_location_session_s *session, location_manager_s **managers)
+{
+	GPtrArray *retired = NULL;
+	pthread_mutex_lock(&session_lock);
+	if (managers != session->fanout)
+		free(managers);
+	session->dispatch_depth--;
+	bool is_outermost = (session->dispatch_depth == 0);
+	if (is_outermost) {
+		retired = session->retired;
+		session->retired = NULL;
+	}
+	bool is_released = (is_outermost && session->managers->len == 0);
+	pthread_mutex_unlock(&session_lock);
+
+	if (retired) {
+		guint i;
+		for (i = 0; i < retired->len; i++)
+			_location_manager_free((location_manager_s *) g_ptr_array_index(retired, i));
+		g_ptr_array_free(retired, TRUE);
+	}
+	if (is_released) {
+		int ret = location_free(session->object);
+		if (ret != LOCATION_ERROR_NONE)
+			LOGE("[%s] fail to location_free (%d)", __FUNCTION__, ret);
+		g_ptr_array_free(session->managers, TRUE);
+		free(session->fanout);
+		free(session);
+	}
+}
+
+static void __cb_session_updated(GObject * self, guint type, gpointer data, gpointer accuracy, gpointer userdata)
+{
+	_location_session_s *session = (_location_session_s *) userdata;
+	location_manager_s **managers;
+	int i, count = __fanout_begin(session, &managers);
+	for (i = 0; i < count; i++) {
+		if (__fanout_check(session, managers[i]))
+			_location_manager_updated(managers[i], type, data, accuracy);
+	}
+	__fanout_end(session, managers);
+}
+
+static void __session_state_changed(_location_session_s *session, location_service_state_e state)
+{
+	session->is_enabled = (state == LOCATIONS_SERVICE_ENABLED);
+
+	location_manager_s **managers;
+	int i, count = __fanout_begin(session, &managers);
+	for (i = 0; i < count; i++) {
+		if (__fanout_check(session, managers[i]))
+			_location_manager_state_changed(managers[i], state);
+	}
+	__fanout_end(session, managers);
+}
+
+static void __cb_session_enabled(GObject * self, guint status, gpointer userdata)
+{
+	__session_state_changed((_location_session_s *) userdata, LOCATIONS_SERVICE_ENABLED);
+}
+
+static void __cb_session_disabled(GObject * self, guint status, gpointer userdata)
+{
+	__session_state_changed((_location_session_s *) userdata, LOCATIONS_SERVICE_DISABLED);
+}
+
+static void __session_zone_changed(_location_session_s *session, location_boundary_state_e state, LocationPosition *pos)
+{
+	location_manager_s **managers;
+	int i, count = __fanout_begin(session, &managers);
+	for (i = 0; i < count; i++) {
+		if (__fanout_check(session, managers[i]))
+			_location_manager_zone_changed(managers[i], state, pos);
+	}
+	__fanout_end(session, managers);
+}
+
+static void __cb_session_zone_in(GObject * self, guint type, gpointer position, gpointer accuracy, gpointer userdata)
+{
+	__session_zone_changed((_location_session_s *) userdata, LOCATIONS_BOUNDARY_IN, (LocationPosition *) position);
+}
+
+static void __cb_session_zone_out(GObject * self, guint type, gpointer position, gpointer accuracy, gpointer userdata)
+{
+	__session_zone_changed((_location_session_s *) userdata, LOCATIONS_BOUNDARY_OUT, (LocationPosition *) position);
+}
+
+/* A manager started while the service is already enabled missed the signal, it gets its own from the main loop */
+static gboolean __enabled_idle(gpointer user_data)
+{
+	location_manager_s *handle = (location_manager_s *) user_data;
+	handle->session_idle = 0;
+	if (handle->is_started && handle->session->is_enabled)
+		_location_manager_state_changed(handle, LOCATIONS_SERVICE_ENABLED);
+	return FALSE;
+}
+
+int _location_session_acquire(location_manager_s *handle, LocationMethod method)
+{
+	pthread_mutex_lock(&session_lock);
+	_location_session_s *session = sessions[handle->method];
+	if (session == NULL) {
+		session = (_location_session_s *) malloc(sizeof(_location_session_s));
+		if (session == NULL) {
+			pthread_mutex_unlock(&session_lock);
+			LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+			return LOCATIONS_ERROR_OUT_OF_MEMORY;
+		}
+		memset(session, 0, sizeof(_location_session_s));
+		session->object = location_new(method);
+		if (session->object == NULL) {
+			pthread_mutex_unlock(&session_lock);
+			free(session);
+			LOGE("[%s] LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE(0x%08x) : fail to location_new", __FUNCTION__,
+			     LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE);
+			return LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE;
+		}
+		session->method = handle->method;
+		session->managers = g_ptr_array_new();
+		g_signal_connect(session->object, "service-enabled", G_CALLBACK(__cb_session_enabled), session);
+		g_signal_connect(session->object, "service-disabled", G_CALLBACK(__cb_session_disabled), session);
+		g_signal_connect(session->object, "service-updated", G_CALLBACK(__cb_session_updated), session);
+		g_signal_connect(session->object, "zone-in", G_CALLBACK(__cb_session_zone_in), session);
+		g_signal_connect(session->object, "zone-out", G_CALLBACK(__cb_session_zone_out), session);
+		sessions[handle->method] = session;
+	}
+	g_ptr_array_add(session->managers, handle);
+	handle->session = session;
+	handle->object = session->object;
+	pthread_mutex_unlock(&session_lock);
+	return LOCATIONS_ERROR_NONE;
+}
+
+int _location_session_release(location_manager_s *handle)
+{
+	_location_session_s *session = handle->session;
+	int ret = _location_session_stop(handle);
+	if (ret != LOCATION_ERROR_NONE)
+		return ret;
+
+	pthread_mutex_lock(&session_lock);
+	if (session->managers->len == 1 && session->dispatch_depth == 0) {
+		ret = location_free(session->object);
+		if (ret != LOCATION_ERROR_NONE) {
+			pthread_mutex_unlock(&session_lock);
+			return ret;
+		}
+		sessions[session->method] = NULL;
+		g_ptr_array_free(session->managers, TRUE);
+		free(session->fanout);
+		free(session);
+	} else {
+		g_ptr_array_remove(session->managers, handle);
+		if (session->dispatch_depth > 0) {
+			/* A callback of the session destroys the manager, the signal may still be on its way to it */
+			if (session->retired == NULL)
+				session->retired = g_ptr_array_new();
+			g_ptr_array_add(session->retired, handle);
+			handle->is_destroyed = TRUE;
+		}
+		if (session->managers->len == 0) {
+			/* Its last manager is gone, the outermost fan-out frees the session */
+			sessions[session->method] = NULL;
+		} else {
+			/* The intervals the manager asked for may have been the shortest */
+			int which;
+			for (which = 0; which < _LOCATION_INTERVAL_NUM; which++) {
+				int interval = __min_interval(session, which);
+				if (handle->intervals[which] > 0 && interval > 0)
+					g_object_set(session->object, interval_properties[which], interval, NULL);
+			}
+		}
+	}
+	pthread_mutex_unlock(&session_lock);
+	handle->session = NULL;
+	handle->object = NULL;
+	return LOCATION_ERROR_NONE;
+}
+
+int _location_session_start(location_manager_s *handle)
+{
+	_location_session_s *session = handle->session;
+	pthread_mutex_lock(&session_lock);
+	if (handle->is_started) {
+		pthread_mutex_unlock(&session_lock);
+		return LOCATION_ERROR_NONE;
+	}
+	if (session->start_count == 0) {
+		int ret = location_start(session->object);
+		if (ret != LOCATION_ERROR_NONE) {
+			pthread_mutex_unlock(&session_lock);
+			return ret;
+		}
+	} else if (session->is_enabled && handle->session_idle == 0) {
+		handle->session_idle = g_idle_add(__enabled_idle, handle);
+	}
+	session->start_count++;
+	handle->is_started = TRUE;
+	pthread_mutex_unlock(&session_lock);
+	return LOCATION_ERROR_NONE;
+}
+
+int _location_session_stop(location_manager_s *handle)
+{
+	_location_session_s *session = handle->session;
+	pthread_mutex_lock(&session_lock);
+	if (!handle->is_started) {
+		pthread_mutex_unlock(&session_lock);
+		return LOCATION_ERROR_NONE;
+	}
+	if (session->start_count == 1) {
+		int ret = location_stop(session->object);
+		if (ret != LOCATION_ERROR_NONE) {
+			pthread_mutex_unlock(&session_lock);
+			return ret;
+		}
+		session->is_enabled = FALSE;
+	}
+	session->start_count--;
+	handle->is_started = FALSE;
+	if (handle->session_idle) {
+		g_source_remove(handle->session_idle);
+		handle->session_idle = 0;
+	}
+	pthread_mutex_unlock(&session_lock);
+	return LOCATION_ERROR_NONE;
+}
+
+void _location_session_set_interval(location_manager_s *handle, _location_interval_e which, int interval)
+{
+	pthread_mutex_lock(&session_lock);
+	handle->intervals[which] = interval;
+	g_object_set(handle->object, interval_properties[which], __min_interval(handle->session, which), NULL);
+	pthread_mutex_unlock(&session_lock);
+}
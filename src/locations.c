@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <locations_private.h>
 #include <dlog.h>
 
@@ -69,81 +70,555 @@ static int __convert_error_code(int code, char *func_name)
 	return ret;
 }
 
-static void __cb_service_updated(GObject * self, guint type, gpointer data, gpointer accuracy, gpointer userdata)
+static void __history_append(location_manager_s *handle, const location_fix_s *fix)
 {
-	LOGI("[%s] Callback function has been invoked. ", __FUNCTION__);
-	location_manager_s *handle = (location_manager_s *) userdata;
-	if (type == VELOCITY_UPDATED && handle->user_cb[_LOCATIONS_EVENT_TYPE_VELOCITY]) {
+	pthread_mutex_lock(&handle->history_lock);
+	handle->history[handle->history_head] = *fix;
+	handle->history_head = (handle->history_head + 1) % LOCATION_MANAGER_HISTORY_CAPACITY;
+	if (handle->history_count < LOCATION_MANAGER_HISTORY_CAPACITY)
+		handle->history_count++;
+	pthread_mutex_unlock(&handle->history_lock);
+}
+
+/* Slot of the index-th oldest recorded fix */
+static inline int __history_slot(const location_manager_s *handle, int index)
+{
+	return (handle->history_head - handle->history_count + index + LOCATION_MANAGER_HISTORY_CAPACITY) % LOCATION_MANAGER_HISTORY_CAPACITY;
+}
+
+/* Copies count fixes starting from the index-th oldest, in at most two runs */
+static void __history_copy(const location_manager_s *handle, int index, int count, location_fix_s *fixes)
+{
+	int slot = __history_slot(handle, index);
+	int first = MIN(count, LOCATION_MANAGER_HISTORY_CAPACITY - slot);
+	memcpy(fixes, &handle->history[slot], sizeof(location_fix_s) * first);
+	memcpy(fixes + first, &handle->history[0], sizeof(location_fix_s) * (count - first));
+}
+
+static location_fix_status_e __convert_fix_status(LocationStatus status)
+{
+	switch (status) {
+	case LOCATION_STATUS_2D_FIX:
+		return LOCATIONS_FIX_2D;
+	case LOCATION_STATUS_3D_FIX:
+		return LOCATIONS_FIX_3D;
+	default:
+		return LOCATIONS_FIX_NONE;
+	}
+}
+
+static void __fill_fix_position(location_fix_s *fix, const LocationPosition *pos, const LocationAccuracy *acc)
+{
+	fix->status = __convert_fix_status(pos->status);
+	fix->latitude = pos->latitude;
+	fix->longitude = pos->longitude;
+	fix->altitude = pos->altitude;
+	fix->timestamp = pos->timestamp;
+	if (acc) {
+		fix->level = acc->level;
+		fix->horizontal_accuracy = acc->horizontal_accuracy;
+		fix->vertical_accuracy = acc->vertical_accuracy;
+	}
+}
+
+/*
+* Latest fix seqlock: the writer makes the sequence odd while it updates the fix,
+* readers retry until they copied it under the same even sequence.
+*/
+static inline void __latest_write_begin(location_manager_s *handle)
+{
+	__atomic_store_n(&handle->latest_seq, handle->latest_seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void __latest_write_end(location_manager_s *handle)
+{
+	__atomic_store_n(&handle->latest_seq, handle->latest_seq + 1, __ATOMIC_RELEASE);
+}
+
+static void __latest_read(location_manager_s *handle, _location_latest_s *latest)
+{
+	unsigned int seq;
+	do {
+		while ((seq = __atomic_load_n(&handle->latest_seq, __ATOMIC_ACQUIRE)) & 1)
+			;
+		memcpy(latest, &handle->latest, sizeof(_location_latest_s));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while (__atomic_load_n(&handle->latest_seq, __ATOMIC_RELAXED) != seq);
+}
+
+static long long __get_clock_ns(clockid_t clock)
+{
+	struct timespec ts;
+	clock_gettime(clock, &ts);
+	return (long long) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void __get_timestamp(location_timestamp_s *time)
+{
+	time->monotonic_ns = __get_clock_ns(CLOCK_MONOTONIC);
+	time->realtime_ns = __get_clock_ns(CLOCK_REALTIME);
+	time->timestamp = 0;
+}
+
+static void __update_latest(location_manager_s *handle, guint type, gpointer data, gpointer accuracy, const location_timestamp_s *time)
+{
+	__latest_write_begin(handle);
+	if (type == POSITION_UPDATED) {
+		__fill_fix_position(&handle->latest.fix, (LocationPosition *) data, (LocationAccuracy *) accuracy);
+		handle->latest.fix.realtime_ns = time->realtime_ns;
+		handle->latest.fix.monotonic_ns = time->monotonic_ns;
+		handle->latest.has_position = TRUE;
+		handle->latest.position_time = *time;
+	} else if (type == VELOCITY_UPDATED) {
 		LocationVelocity *vel = (LocationVelocity *) data;
-		LOGI("[%s] Current velocity: timestamp : %d, speed: %f, direction : %f, climb : %f", __FUNCTION__,
-		     vel->timestamp, vel->speed, vel->direction, vel->climb);
-		((location_velocity_updated_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_VELOCITY]) (vel->speed, vel->direction,
-												  vel->climb, vel->timestamp,
-												  handle->user_data
-												  [_LOCATIONS_EVENT_TYPE_VELOCITY]);
+		handle->latest.fix.speed = vel->speed;
+		handle->latest.fix.direction = vel->direction;
+		handle->latest.fix.climb = vel->climb;
+		handle->latest.has_velocity = TRUE;
+		handle->latest.velocity_time = *time;
+	} else if (type == SATELLITE_UPDATED) {
+		LocationSatellite *sat = (LocationSatellite *) data;
+		handle->latest.fix.num_of_sat_used = sat->num_of_sat_used;
+		handle->latest.has_satellite = TRUE;
+		handle->latest.satellite_time = *time;
 	}
-	else if (type == POSITION_UPDATED && handle->user_cb[_LOCATIONS_EVENT_TYPE_POSITION]) {
-		LocationPosition *pos = (LocationPosition *) data;
+	if (handle->is_smoothing && (type == POSITION_UPDATED || type == VELOCITY_UPDATED)) {
+		gint64 now = time->monotonic_ns / 1000;
+		if (type == POSITION_UPDATED) {
+			_location_kalman_update_position(&handle->kalman, &handle->latest.fix, now);
+		} else {
+			LocationVelocity *vel = (LocationVelocity *) data;
+			_location_kalman_update_velocity(&handle->kalman, vel->speed, vel->direction, vel->climb, now);
+		}
+		if (handle->kalman.is_initialized) {
+			handle->latest.smoothed = handle->latest.fix;
+			_location_kalman_get_fix(&handle->kalman, &handle->latest.smoothed);
+			handle->latest.has_smoothed = TRUE;
+			handle->latest.smoothed_time = handle->kalman.time;
+		}
+	}
+	__latest_write_end(handle);
+
+	if (type == POSITION_UPDATED)
+		__history_append(handle, &handle->latest.fix);
+}
+
+static void __batch_flush(location_manager_s *handle)
+{
+	if (handle->batch_timer) {
+		g_source_remove(handle->batch_timer);
+		handle->batch_timer = 0;
+	}
+	if (handle->batch_count == 0 || !handle->user_cb[_LOCATIONS_EVENT_TYPE_BATCH])
+		return;
+
+	int count = handle->batch_count;
+	handle->batch_count = 0;
+	LOGI("[%s] Delivering %d fixes", __FUNCTION__, count);
+	((location_batch_updated_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_BATCH]) (handle->batch, count,
+										    handle->user_data[_LOCATIONS_EVENT_TYPE_BATCH]);
+}
+
+static gboolean __batch_timeout(gpointer user_data)
+{
+	location_manager_s *handle = (location_manager_s *) user_data;
+	handle->batch_timer = 0;
+	__batch_flush(handle);
+	return FALSE;
+}
+
+static void __batch_discard(location_manager_s *handle)
+{
+	if (handle->batch_timer) {
+		g_source_remove(handle->batch_timer);
+		handle->batch_timer = 0;
+	}
+	handle->batch_count = 0;
+}
+
+static void __batch_append(location_manager_s *handle, const location_fix_s *fix)
+{
+	handle->batch[handle->batch_count++] = *fix;
+	if (handle->batch_count >= handle->batch_max_count)
+		__batch_flush(handle);
+	else if (handle->batch_count == 1 && handle->batch_period > 0)
+		handle->batch_timer = g_timeout_add_seconds(handle->batch_period, __batch_timeout, handle);
+}
+
+/*
+* Distance filter of the position callback. An equirectangular approximation is enough to compare
+* against the threshold, the central angles involved are small.
+*/
+static bool __position_filter_pass(location_manager_s *handle, const LocationPosition *pos)
+{
+	if (handle->filter_square <= 0)
+		return TRUE;
+	/* A position without fix is delivered as it is, but its coordinates are no reference */
+	if (__convert_fix_status(pos->status) == LOCATIONS_FIX_NONE)
+		return TRUE;
+
+	double latitude = LOCATIONS_DEG_TO_RAD(pos->latitude);
+	double longitude = LOCATIONS_DEG_TO_RAD(pos->longitude);
+	if (handle->has_reported) {
+		double dlat = latitude - handle->reported_latitude;
+		double dlon = longitude - handle->reported_longitude;
+		if (dlon > M_PI)
+			dlon -= 2 * M_PI;
+		else if (dlon < -M_PI)
+			dlon += 2 * M_PI;
+		dlon *= handle->reported_cos_latitude;
+		if (dlat * dlat + dlon * dlon < handle->filter_square)
+			return FALSE;
+	}
+
+	handle->has_reported = TRUE;
+	handle->reported_latitude = latitude;
+	handle->reported_longitude = longitude;
+	handle->reported_cos_latitude = cos(latitude);
+	return TRUE;
+}
+
+/* Same conventions as location_manager_get_position(): -1 for values the fix does not provide */
+static void __get_cached_position(const location_fix_s *fix, double *altitude, double *latitude, double *longitude, time_t *timestamp)
+{
+	if (fix->status == LOCATIONS_FIX_NONE) {
+		*altitude = -1;
+		*latitude = -1;
+		*longitude = -1;
+	} else {
+		*altitude = (fix->status == LOCATIONS_FIX_3D) ? fix->altitude : -1;
+		*latitude = fix->latitude;
+		*longitude = fix->longitude;
+	}
+	*timestamp = fix->timestamp;
+}
+
+/* Invokes a callback of the type of the event, the _NS variants excepted */
+static void __event_invoke(const _location_event_s *event, const void *cb, void *user_data)
+{
+	switch (event->type) {
+	case _LOCATIONS_EVENT_TYPE_SERVICE_STATE:
+		((location_service_state_changed_cb) cb) (event->state, user_data);
+		break;
+	case _LOCATIONS_EVENT_TYPE_POSITION:
 		LOGI("[%s] Current position: timestamp : %d, latitude : %f, altitude: %f, longitude: %f", __FUNCTION__,
-		     pos->timestamp, pos->latitude, pos->altitude, pos->longitude);
-		((location_position_updated_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_POSITION]) (pos->latitude, pos->longitude,
-												  pos->altitude, pos->timestamp,
-												  handle->user_data
-												  [_LOCATIONS_EVENT_TYPE_POSITION]);
-	}
-	else if (type == SATELLITE_UPDATED && handle->user_cb[_LOCATIONS_EVENT_TYPE_SATELLITE]) {
-		LocationSatellite *sat = (LocationSatellite *)data;
+		     event->time.timestamp, event->values[0], event->values[2], event->values[1]);
+		((location_position_updated_cb) cb) (event->values[0], event->values[1], event->values[2], event->time.timestamp, user_data);
+		break;
+	case _LOCATIONS_EVENT_TYPE_VELOCITY:
+		LOGI("[%s] Current velocity: timestamp : %d, speed: %f, direction : %f, climb : %f", __FUNCTION__,
+		     event->time.timestamp, event->values[0], event->values[1], event->values[2]);
+		((location_velocity_updated_cb) cb) (event->values[0], event->values[1], event->values[2], event->time.timestamp, user_data);
+		break;
+	case _LOCATIONS_EVENT_TYPE_SATELLITE:
 		LOGI("[%s] Current satellite information: timestamp : %d, number of active : %d, number of inview : %d", __FUNCTION__,
-		     sat->timestamp, sat->num_of_sat_used, sat->num_of_sat_inview);
-		((gps_status_satellite_updated_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_SATELLITE]) (sat->num_of_sat_used, sat->num_of_sat_inview,
-												 sat->timestamp, handle->user_data[_LOCATIONS_EVENT_TYPE_SATELLITE]);
+		     event->time.timestamp, event->num_of_active, event->num_of_inview);
+		((gps_status_satellite_updated_cb) cb) (event->num_of_active, event->num_of_inview, event->time.timestamp, user_data);
+		break;
+	case _LOCATIONS_EVENT_TYPE_BOUNDARY:
+		((location_zone_changed_cb) cb) (event->state, event->values[0], event->values[1], event->values[2], event->time.timestamp,
+						 user_data);
+		break;
+	case _LOCATIONS_EVENT_TYPE_SMOOTHED:
+		((location_smoothed_updated_cb) cb) (&event->fix, user_data);
+		break;
+	default:
+		break;
 	}
 }
 
-static void __cb_service_enabled(GObject * self, guint status, gpointer userdata)
+void _location_event_deliver(location_manager_s *handle, const _location_event_s *event)
+{
+	/* The callbacks are read again here, the event may have waited in the dispatch queue */
+	switch (event->type) {
+	case _LOCATIONS_EVENT_TYPE_POSITION:
+		if (handle->user_cb[_LOCATIONS_EVENT_TYPE_POSITION_NS])
+			((location_position_updated_ns_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_POSITION_NS]) (event->values[0], event->values[1],
+														event->values[2], &event->time,
+														handle->user_data
+														[_LOCATIONS_EVENT_TYPE_POSITION_NS]);
+		break;
+	case _LOCATIONS_EVENT_TYPE_VELOCITY:
+		if (handle->user_cb[_LOCATIONS_EVENT_TYPE_VELOCITY_NS])
+			((location_velocity_updated_ns_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_VELOCITY_NS]) (event->values[0], event->values[1],
+														event->values[2], &event->time,
+														handle->user_data
+														[_LOCATIONS_EVENT_TYPE_VELOCITY_NS]);
+		break;
+	case _LOCATIONS_EVENT_TYPE_SATELLITE:
+		if (handle->user_cb[_LOCATIONS_EVENT_TYPE_SATELLITE_NS])
+			((gps_status_satellite_updated_ns_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_SATELLITE_NS]) (event->num_of_active,
+														    event->num_of_inview, &event->time,
+														    handle->user_data
+														    [_LOCATIONS_EVENT_TYPE_SATELLITE_NS]);
+		break;
+	case _LOCATIONS_EVENT_TYPE_BOUNDARY:
+		if (handle->user_cb[_LOCATIONS_EVENT_TYPE_BOUNDARY_NS])
+			((location_zone_changed_ns_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_BOUNDARY_NS]) (event->state, event->values[0],
+													    event->values[1], event->values[2],
+													    &event->time,
+													    handle->user_data
+													    [_LOCATIONS_EVENT_TYPE_BOUNDARY_NS]);
+		break;
+	default:
+		break;
+	}
+
+	const void *cb = handle->user_cb[event->type];
+	if (cb)
+		__event_invoke(event, cb, handle->user_data[event->type]);
+
+	/* A callback may have destroyed the manager, see _location_session_release() */
+	const _location_listener_array_s *array = _location_listeners_acquire(handle, event->type);
+	if (array) {
+		int i;
+		for (i = 0; i < array->count && !handle->is_destroyed; i++)
+			__event_invoke(event, array->listeners[i].cb, array->listeners[i].user_data);
+	}
+	_location_listeners_release(handle);
+}
+
+/* Whether an event of the type has anyone to deliver to, the _NS variant aside */
+static inline bool __is_listened(location_manager_s *handle, _location_event_e type)
+{
+	return handle->user_cb[type] || (__atomic_load_n(&handle->listeners[type], __ATOMIC_RELAXED) && !handle->is_destroyed);
+}
+
+static void __event_post(location_manager_s *handle, const _location_event_s *event)
+{
+	if (handle->dispatch)
+		_location_dispatch_push(handle->dispatch, event);
+	else
+		_location_event_deliver(handle, event);
+}
+
+/* pos-interval of the object, the position callbacks accept up to 120 seconds */
+static void __duty_cycle_apply(location_manager_s *handle, int interval)
+{
+	if (interval > 120)
+		interval = 120;
+	if (handle->duty_cycle->applied_interval != interval) {
+		handle->duty_cycle->applied_interval = interval;
+		g_object_set(handle->object, "pos-interval", interval, NULL);
+	}
+}
+
+static gboolean __duty_cycle_wake(gpointer user_data);
+
+/* Starts the service stopped by the duty cycle, a failed start is retried after the current interval */
+static int __duty_cycle_restart(location_manager_s *handle)
+{
+	_location_duty_cycle_s *duty = handle->duty_cycle;
+	duty->wake_ns = __get_clock_ns(CLOCK_MONOTONIC);
+	__duty_cycle_apply(handle, duty->min_interval);
+	int ret = location_start(handle->object);
+	if (ret != LOCATION_ERROR_NONE) {
+		LOGE("[%s] fail to start the service (%d), retry in %d seconds", __FUNCTION__, ret, duty->interval);
+		duty->timer = g_timeout_add_seconds(duty->interval, __duty_cycle_wake, handle);
+		return ret;
+	}
+	duty->is_sleeping = FALSE;
+	duty->is_waking = TRUE;
+	return LOCATION_ERROR_NONE;
+}
+
+static gboolean __duty_cycle_wake(gpointer user_data)
+{
+	location_manager_s *handle = (location_manager_s *) user_data;
+	handle->duty_cycle->timer = 0;
+	__duty_cycle_restart(handle);
+	return FALSE;
+}
+
+/* Returns TRUE if the backend was stopped by the duty cycle */
+static bool __duty_cycle_cancel(location_manager_s *handle)
+{
+	_location_duty_cycle_s *duty = handle->duty_cycle;
+	if (duty->timer) {
+		g_source_remove(duty->timer);
+		duty->timer = 0;
+	}
+	bool is_sleeping = duty->is_sleeping;
+	duty->is_sleeping = FALSE;
+	duty->is_waking = FALSE;
+	return is_sleeping;
+}
+
+static void __duty_cycle_update(location_manager_s *handle, const location_timestamp_s *time)
+{
+	_location_duty_cycle_s *duty = handle->duty_cycle;
+	/* A fix may still come in after the backend was stopped */
+	if (duty->is_sleeping || !handle->is_started)
+		return;
+
+	/* A velocity from before the backend was started again describes the previous fix */
+	double speed = -1;
+	if (handle->latest.has_velocity && handle->latest.velocity_time.monotonic_ns >= duty->wake_ns)
+		speed = handle->latest.fix.speed / 3.6;
+	int sleep = _location_duty_cycle_update(duty, &handle->latest.fix, speed, time->monotonic_ns);
+	if (sleep > 0) {
+		int ret = location_stop(handle->object);
+		if (ret == LOCATION_ERROR_NONE) {
+			LOGI("[%s] Stopping the service for %d seconds", __FUNCTION__, sleep);
+			duty->is_sleeping = TRUE;
+			duty->is_waking = FALSE;
+			duty->timer = g_timeout_add_seconds(sleep, __duty_cycle_wake, handle);
+			return;
+		}
+		LOGE("[%s] fail to stop the service (%d)", __FUNCTION__, ret);
+	}
+	__duty_cycle_apply(handle, duty->interval);
+}
+
+void _location_manager_updated(location_manager_s *handle, guint type, gpointer data, gpointer accuracy)
+{
+	_location_event_s event;
+	__get_timestamp(&event.time);
+	if (type == POSITION_UPDATED)
+		event.time.timestamp = ((LocationPosition *) data)->timestamp;
+	else if (type == VELOCITY_UPDATED)
+		event.time.timestamp = ((LocationVelocity *) data)->timestamp;
+	else if (type == SATELLITE_UPDATED)
+		event.time.timestamp = ((LocationSatellite *) data)->timestamp;
+	__update_latest(handle, type, data, accuracy, &event.time);
+
+	if (type == POSITION_UPDATED && handle->user_cb[_LOCATIONS_EVENT_TYPE_BATCH])
+		__batch_append(handle, &handle->latest.fix);
+	if (type == POSITION_UPDATED)
+		_location_geofence_update(handle, &handle->latest.fix);
+	if (type == POSITION_UPDATED && handle->duty_cycle)
+		__duty_cycle_update(handle, &event.time);
+	if (type == POSITION_UPDATED && handle->latest.has_smoothed && handle->latest.fix.status != LOCATIONS_FIX_NONE
+	    && __is_listened(handle, _LOCATIONS_EVENT_TYPE_SMOOTHED)) {
+		event.type = _LOCATIONS_EVENT_TYPE_SMOOTHED;
+		event.fix = handle->latest.smoothed;
+		__event_post(handle, &event);
+	}
+
+	if (type == VELOCITY_UPDATED
+	    && (__is_listened(handle, _LOCATIONS_EVENT_TYPE_VELOCITY) || handle->user_cb[_LOCATIONS_EVENT_TYPE_VELOCITY_NS])) {
+		LocationVelocity *vel = (LocationVelocity *) data;
+		event.type = _LOCATIONS_EVENT_TYPE_VELOCITY;
+		event.values[0] = vel->speed;
+		event.values[1] = vel->direction;
+		event.values[2] = vel->climb;
+		__event_post(handle, &event);
+	}
+	/* The distance filter keeps state, it is evaluated only when a position callback is set */
+	else if (type == POSITION_UPDATED
+		 && (__is_listened(handle, _LOCATIONS_EVENT_TYPE_POSITION) || handle->user_cb[_LOCATIONS_EVENT_TYPE_POSITION_NS])
+		 && __position_filter_pass(handle, (LocationPosition *) data)) {
+		LocationPosition *pos = (LocationPosition *) data;
+		event.type = _LOCATIONS_EVENT_TYPE_POSITION;
+		event.values[0] = pos->latitude;
+		event.values[1] = pos->longitude;
+		event.values[2] = pos->altitude;
+		__event_post(handle, &event);
+	}
+	else if (type == SATELLITE_UPDATED
+		 && (__is_listened(handle, _LOCATIONS_EVENT_TYPE_SATELLITE) || handle->user_cb[_LOCATIONS_EVENT_TYPE_SATELLITE_NS])) {
+		LocationSatellite *sat = (LocationSatellite *) data;
+		event.type = _LOCATIONS_EVENT_TYPE_SATELLITE;
+		event.num_of_active = sat->num_of_sat_used;
+		event.num_of_inview = sat->num_of_sat_inview;
+		__event_post(handle, &event);
+	}
+}
+
+static void __cb_service_updated(GObject * self, guint type, gpointer data, gpointer accuracy, gpointer userdata)
 {
 	LOGI("[%s] Callback function has been invoked. ", __FUNCTION__);
-	location_manager_s *handle = (location_manager_s *) userdata;
-	if (handle->user_cb[_LOCATIONS_EVENT_TYPE_SERVICE_STATE]) {
-		((location_service_state_changed_cb)
-		 handle->user_cb[_LOCATIONS_EVENT_TYPE_SERVICE_STATE]) (LOCATIONS_SERVICE_ENABLED,
-									handle->user_data[_LOCATIONS_EVENT_TYPE_SERVICE_STATE]);
+	_location_manager_updated((location_manager_s *) userdata, type, data, accuracy);
+}
+
+void _location_manager_state_changed(location_manager_s *handle, location_service_state_e state)
+{
+	/* The application still sees the service enabled while the duty cycle stops and starts it */
+	_location_duty_cycle_s *duty = handle->duty_cycle;
+	if (duty && duty->is_sleeping && state == LOCATIONS_SERVICE_DISABLED)
+		return;
+	if (duty && duty->is_waking && state == LOCATIONS_SERVICE_ENABLED) {
+		duty->is_waking = FALSE;
+		return;
 	}
+
+	if (__is_listened(handle, _LOCATIONS_EVENT_TYPE_SERVICE_STATE)) {
+		_location_event_s event;
+		__get_timestamp(&event.time);
+		event.type = _LOCATIONS_EVENT_TYPE_SERVICE_STATE;
+		event.state = state;
+		__event_post(handle, &event);
+	}
+}
+
+static void __cb_service_enabled(GObject * self, guint status, gpointer userdata)
+{
+	LOGI("[%s] Callback function has been invoked. ", __FUNCTION__);
+	_location_manager_state_changed((location_manager_s *) userdata, LOCATIONS_SERVICE_ENABLED);
 }
 
 static void __cb_service_disabled(GObject * self, guint status, gpointer userdata)
 {
 	LOGI("[%s] Callback function has been invoked. ", __FUNCTION__);
-	location_manager_s *handle = (location_manager_s *) userdata;
-	if (handle->user_cb[_LOCATIONS_EVENT_TYPE_SERVICE_STATE])
-		((location_service_state_changed_cb)
-		 handle->user_cb[_LOCATIONS_EVENT_TYPE_SERVICE_STATE]) (LOCATIONS_SERVICE_DISABLED,
-									handle->user_data[_LOCATIONS_EVENT_TYPE_SERVICE_STATE]);
+	_location_manager_state_changed((location_manager_s *) userdata, LOCATIONS_SERVICE_DISABLED);
 }
 
-static void __cb_zone_in(GObject * self, guint type, gpointer position, gpointer accuracy, gpointer userdata)
+void _location_manager_zone_changed(location_manager_s *handle, location_boundary_state_e state, LocationPosition *pos)
 {
-	location_manager_s *handle = (location_manager_s *) userdata;
-	if (handle->user_cb[_LOCATIONS_EVENT_TYPE_BOUNDARY]) {
-		LocationPosition *pos = (LocationPosition *) position;
-		((location_zone_changed_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_BOUNDARY]) (LOCATIONS_BOUNDARY_IN,
-											      pos->latitude, pos->longitude,
-											      pos->altitude, pos->timestamp,
-											      handle->user_data
-											      [_LOCATIONS_EVENT_TYPE_BOUNDARY]);
+	_location_event_s event;
+	__get_timestamp(&event.time);
+	event.time.timestamp = pos->timestamp;
+
+	if (__is_listened(handle, _LOCATIONS_EVENT_TYPE_BOUNDARY) || handle->user_cb[_LOCATIONS_EVENT_TYPE_BOUNDARY_NS]) {
+		event.type = _LOCATIONS_EVENT_TYPE_BOUNDARY;
+		event.state = state;
+		event.values[0] = pos->latitude;
+		event.values[1] = pos->longitude;
+		event.values[2] = pos->altitude;
+		__event_post(handle, &event);
 	}
 }
 
+static void __cb_zone_in(GObject * self, guint type, gpointer position, gpointer accuracy, gpointer userdata)
+{
+	_location_manager_zone_changed((location_manager_s *) userdata, LOCATIONS_BOUNDARY_IN, (LocationPosition *) position);
+}
+
 static void __cb_zone_out(GObject * self, guint type, gpointer position, gpointer accuracy, gpointer userdata)
 {
-	location_manager_s *handle = (location_manager_s *) userdata;
-	if (handle->user_cb[_LOCATIONS_EVENT_TYPE_BOUNDARY]) {
-		LocationPosition *pos = (LocationPosition *) position;
-		((location_zone_changed_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_BOUNDARY]) (LOCATIONS_BOUNDARY_OUT,
-											      pos->latitude, pos->longitude,
-											      pos->altitude, pos->timestamp,
-											      handle->user_data
-											      [_LOCATIONS_EVENT_TYPE_BOUNDARY]);
+	_location_manager_zone_changed((location_manager_s *) userdata, LOCATIONS_BOUNDARY_OUT, (LocationPosition *) position);
+}
+
+static const struct {
+	const char *name;
+	GCallback callback;
+} signal_handlers[_LOCATION_SIGNAL_NUM] = {
+	[_LOCATION_SIGNAL_SERVICE_ENABLED] = { "service-enabled", G_CALLBACK(__cb_service_enabled) },
+	[_LOCATION_SIGNAL_SERVICE_DISABLED] = { "service-disabled", G_CALLBACK(__cb_service_disabled) },
+	[_LOCATION_SIGNAL_SERVICE_UPDATED] = { "service-updated", G_CALLBACK(__cb_service_updated) },
+	[_LOCATION_SIGNAL_ZONE_IN] = { "zone-in", G_CALLBACK(__cb_zone_in) },
+	[_LOCATION_SIGNAL_ZONE_OUT] = { "zone-out", G_CALLBACK(__cb_zone_out) },
+};
+
+/* The handlers stay connected across stop and start, each signal reaches the manager once */
+static void __connect_signals(location_manager_s *handle)
+{
+	int i;
+	for (i = 0; i < _LOCATION_SIGNAL_NUM; i++) {
+		if (handle->signal_ids[i] == 0)
+			handle->signal_ids[i] = g_signal_connect(handle->object, signal_handlers[i].name, signal_handlers[i].callback, handle);
+	}
+}
+
+static void __disconnect_signals(location_manager_s *handle)
+{
+	int i;
+	for (i = 0; i < _LOCATION_SIGNAL_NUM; i++) {
+		if (handle->signal_ids[i]) {
+			g_signal_handler_disconnect(handle->object, handle->signal_ids[i]);
+			handle->signal_ids[i] = 0;
+		}
 	}
 }
 
@@ -168,60 +643,26 @@ static int __unset_callback(_location_event_e type, location_manager_h manager)
 	return LOCATIONS_ERROR_NONE;
 }
 
-static void __foreach_boundary(LocationBoundary * boundary, void *user_data)
+/* A shared object runs at the shortest interval any of its managers asked for */
+static void __set_interval(location_manager_s *handle, _location_interval_e which, const char *property, int interval)
 {
-	location_manager_s *handle = (location_manager_s *) user_data;
-
-	if (handle != NULL && boundary != NULL) {
-		int ret = -1;
-		location_bounds_h bounds;
-		if (boundary->type == LOCATION_BOUNDARY_CIRCLE) {
-			location_coords_s center;
-			center.latitude = boundary->circle.center->latitude;
-			center.longitude = boundary->circle.center->longitude;
-			ret = location_bounds_create_circle(center, boundary->circle.radius, &bounds);
-		} else if (boundary->type == LOCATION_BOUNDARY_RECT) {
-			location_coords_s left_top;
-			location_coords_s right_bottom;
-			left_top.latitude = boundary->rect.left_top->latitude;
-			left_top.longitude = boundary->rect.left_top->longitude;
-			right_bottom.latitude = boundary->rect.right_bottom->latitude;
-			right_bottom.longitude = boundary->rect.right_bottom->longitude;
-			ret = location_bounds_create_rect(left_top, right_bottom, &bounds);
-		} else if (boundary->type == LOCATION_BOUNDARY_POLYGON) {
-			GList *list = boundary->polygon.position_list;
-			int size = g_list_length(list);
-			if (size > 0) {
-				location_coords_s coords[size];
-				int cnt = 0;
-				while (list) {
-					LocationPosition *pos = list->data;
-					coords[cnt].latitude = pos->latitude;
-					coords[cnt].longitude = pos->longitude;
-					list = g_list_next(list);
-					cnt++;
-				}
-				ret = location_bounds_create_polygon(coords, size, &bounds);
-			}
-		} else {
-			LOGI("[%s] Invalid boundary type : %d", __FUNCTION__, boundary->type);
-		}
-
-		if (ret != LOCATIONS_ERROR_NONE) {
-			LOGI("[%s] Failed to create location_bounds : (0x%08x) ", __FUNCTION__, ret);
-		} else {
-			if (handle->is_continue_foreach_bounds) {
-				handle->is_continue_foreach_bounds =
-				    ((location_bounds_cb) handle->user_cb[_LOCATIONS_EVENT_TYPE_FOREACH_BOUNDS]) (bounds,
-														  handle->
-														  user_data
-														  [_LOCATIONS_EVENT_TYPE_FOREACH_BOUNDS]);
-			}
-			location_bounds_destroy(bounds);
-		}
-	} else {
-		LOGI("[%s]  __foreach_boundary() has been failed", __FUNCTION__);
+	if (handle->session) {
+		_location_session_set_interval(handle, which, interval);
+		return;
 	}
+	handle->intervals[which] = interval;
+	/* The duty cycle owns the position interval, this one is restored when it is unset */
+	if (which != _LOCATION_INTERVAL_POSITION || handle->duty_cycle == NULL)
+		g_object_set(handle->object, property, interval, NULL);
+}
+
+static void __boundaries_free(location_manager_s *handle)
+{
+	guint i;
+	for (i = 0; i < handle->boundaries->len; i++)
+		location_bounds_destroy((location_bounds_h) g_ptr_array_index(handle->boundaries, i));
+	g_ptr_array_free(handle->boundaries, TRUE);
+	handle->boundaries = NULL;
 }
 
 /////////////////////////////////////////
@@ -255,7 +696,7 @@ bool location_manager_is_supported_method(location_method_e method)
 	return location_is_supported_method(_method);
 }
 
-int location_manager_create(location_method_e method, location_manager_h * manager)
+static int __create(location_method_e method, location_manager_h * manager, bool is_shared)
 {
 	LOCATIONS_NULL_ARG_CHECK(manager);
 	if (location_init() != LOCATION_ERROR_NONE)
@@ -292,48 +733,118 @@ int location_manager_create(location_method_e method, location_manager_h * manag
 	}
 
 	memset(handle, 0, sizeof(location_manager_s));
+	handle->method = method;
 
-	handle->object = location_new(_method);
-	if (handle->object == NULL) {
-		LOGE("[%s] LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE(0x%08x) : fail to location_new", __FUNCTION__,
-		     LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE);
-		free(handle);
-		return LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE;
+	if (is_shared) {
+		int ret = _location_session_acquire(handle, _method);
+		if (ret != LOCATIONS_ERROR_NONE) {
+			free(handle);
+			return ret;
+		}
+	} else {
+		handle->object = location_new(_method);
+		if (handle->object == NULL) {
+			LOGE("[%s] LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE(0x%08x) : fail to location_new", __FUNCTION__,
+			     LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE);
+			free(handle);
+			return LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE;
+		}
 	}
-	handle->method = method;
-	handle->is_continue_foreach_bounds = TRUE;
+	handle->boundaries = g_ptr_array_new();
+	pthread_mutex_init(&handle->history_lock, NULL);
+	pthread_mutex_init(&handle->listener_lock, NULL);
 	*manager = (location_manager_h) handle;
 	return LOCATIONS_ERROR_NONE;
 }
 
+int location_manager_create(location_method_e method, location_manager_h * manager)
+{
+	return __create(method, manager, FALSE);
+}
+
+int location_manager_create_shared(location_method_e method, location_manager_h * manager)
+{
+	return __create(method, manager, TRUE);
+}
+
 int location_manager_destroy(location_manager_h manager)
 {
 	LOCATIONS_NULL_ARG_CHECK(manager);
 	location_manager_s *handle = (location_manager_s *) manager;
+	/* The dispatch thread would join itself and free the state its callback runs on */
+	LOCATIONS_CHECK_CONDITION(handle->dispatch == NULL || !_location_dispatch_is_current_thread(handle->dispatch), LOCATIONS_ERROR_INVALID_PARAMETER,
+				  "LOCATIONS_ERROR_INVALID_PARAMETER");
 
-	int ret = location_free(handle->object);
+	int ret;
+	if (handle->session) {
+		/* The other managers keep the object, take this manager's boundaries off it */
+		guint i;
+		for (i = 0; i < handle->boundaries->len; i++)
+			location_boundary_remove(handle->object,
+						 _location_bounds_get_boundary((location_bounds_s *) g_ptr_array_index(handle->boundaries, i)));
+		ret = _location_session_release(handle);
+	} else {
+		__disconnect_signals(handle);
+		ret = location_free(handle->object);
+	}
 	if (ret != LOCATIONS_ERROR_NONE) {
 		return __convert_error_code(ret, (char *)__FUNCTION__);
 	}
-	free(handle);
+	if (handle->dispatch) {
+		_location_dispatch_destroy(handle->dispatch);
+		handle->dispatch = NULL;
+	}
+	if (handle->duty_cycle)
+		__duty_cycle_cancel(handle);
+	if (handle->is_destroyed) {
+		/* Destroyed from a callback of its session, which frees it once the signal is delivered */
+		memset(handle->user_cb, 0, sizeof(handle->user_cb));
+		return LOCATIONS_ERROR_NONE;
+	}
+	_location_manager_free(handle);
 	return LOCATIONS_ERROR_NONE;
 }
 
+void _location_manager_free(location_manager_s *handle)
+{
+	free(handle->duty_cycle);
+	__batch_discard(handle);
+	_location_geofence_destroy(handle);
+	__boundaries_free(handle);
+	_location_listeners_destroy(handle);
+	pthread_mutex_destroy(&handle->listener_lock);
+	pthread_mutex_destroy(&handle->history_lock);
+	free(handle);
+}
+
 int location_manager_start(location_manager_h manager)
 {
 	LOCATIONS_NULL_ARG_CHECK(manager);
 	location_manager_s *handle = (location_manager_s *) manager;
 
-	g_signal_connect(handle->object, "service-enabled", G_CALLBACK(__cb_service_enabled), handle);
-	g_signal_connect(handle->object, "service-disabled", G_CALLBACK(__cb_service_disabled), handle);
-	g_signal_connect(handle->object, "service-updated", G_CALLBACK(__cb_service_updated), handle);
-	g_signal_connect(handle->object, "zone-in", G_CALLBACK(__cb_zone_in), handle);
-	g_signal_connect(handle->object, "zone-out", G_CALLBACK(__cb_zone_out), handle);
+	if (handle->session) {
+		int ret = _location_session_start(handle);
+		if (ret != LOCATION_ERROR_NONE) {
+			return __convert_error_code(ret, (char *)__FUNCTION__);
+		}
+		return LOCATIONS_ERROR_NONE;
+	}
 
+	if (handle->is_started)
+		return LOCATIONS_ERROR_NONE;
+
+	__connect_signals(handle);
 	int ret = location_start(handle->object);
 	if (ret != LOCATION_ERROR_NONE) {
 		return __convert_error_code(ret, (char *)__FUNCTION__);
 	}
+	handle->is_started = TRUE;
+	if (handle->duty_cycle) {
+		_location_duty_cycle_s *duty = handle->duty_cycle;
+		_location_duty_cycle_reset(duty, duty->policy, duty->min_interval, duty->max_interval);
+		duty->wake_ns = __get_clock_ns(CLOCK_MONOTONIC);
+		__duty_cycle_apply(handle, duty->min_interval);
+	}
 	return LOCATIONS_ERROR_NONE;
 }
 
@@ -342,53 +853,222 @@ int location_manager_stop(location_manager_h manager)
 	LOCATIONS_NULL_ARG_CHECK(manager);
 	location_manager_s *handle = (location_manager_s *) manager;
 
-	int ret = location_stop(handle->object);
+	if (handle->session) {
+		int ret = _location_session_stop(handle);
+		if (ret != LOCATION_ERROR_NONE) {
+			return __convert_error_code(ret, (char *)__FUNCTION__);
+		}
+	} else if (handle->is_started && handle->duty_cycle && __duty_cycle_cancel(handle)) {
+		/* Already stopped by the duty cycle, which kept service-disabled from the application */
+		handle->is_started = FALSE;
+		_location_manager_state_changed(handle, LOCATIONS_SERVICE_DISABLED);
+	} else if (handle->is_started) {
+		int ret = location_stop(handle->object);
+		if (ret != LOCATION_ERROR_NONE) {
+			return __convert_error_code(ret, (char *)__FUNCTION__);
+		}
+		handle->is_started = FALSE;
+	}
+	__batch_flush(handle);
+	return LOCATIONS_ERROR_NONE;
+}
+
+static int __add_boundary_copy(location_manager_s *handle, location_bounds_s *copy)
+{
+	LocationBoundary *boundary = _location_bounds_get_boundary(copy);
+	if (boundary == NULL) {
+		LOGE("[%s] LOCATIONS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to create boundary", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+		return LOCATIONS_ERROR_OUT_OF_MEMORY;
+	}
+	int ret = location_boundary_add(handle->object, boundary);
 	if (ret != LOCATION_ERROR_NONE) {
 		return __convert_error_code(ret, (char *)__FUNCTION__);
 	}
 	return LOCATIONS_ERROR_NONE;
 }
 
+/* Removes the registered copy equal to bounds, if any */
+static void __remove_boundary_copy(location_manager_s *handle, const location_bounds_s *bounds)
+{
+	guint i;
+	for (i = 0; i < handle->boundaries->len; i++) {
+		location_bounds_s *copy = (location_bounds_s *) g_ptr_array_index(handle->boundaries, i);
+		if (_location_bounds_equals(copy, bounds)) {
+			g_ptr_array_remove_index(handle->boundaries, i);
+			location_bounds_destroy((location_bounds_h) copy);
+			return;
+		}
+	}
+}
+
+/* Removes the copies from index first on, which the caller has just added */
+static void __truncate_boundaries(location_manager_s *handle, guint first)
+{
+	while (handle->boundaries->len > first) {
+		location_bounds_s *copy = (location_bounds_s *) g_ptr_array_remove_index(handle->boundaries, handle->boundaries->len - 1);
+		location_boundary_remove(handle->object, _location_bounds_get_boundary(copy));
+		location_bounds_destroy((location_bounds_h) copy);
+	}
+}
+
 int location_manager_add_boundary(location_manager_h manager, const location_bounds_h bounds)
 {
 	LOCATIONS_NULL_ARG_CHECK(manager);
 	LOCATIONS_NULL_ARG_CHECK(bounds);
+	return location_manager_add_boundaries(manager, &bounds, 1);
+}
 
-	location_manager_s *handle = (location_manager_s *) manager;
-	int ret = location_boundary_add(handle->object,(LocationBoundary*)bounds);
+int location_manager_add_boundaries(location_manager_h manager, const location_bounds_h *bounds, int count)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(bounds);
+	LOCATIONS_CHECK_CONDITION(count > 0, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	int i;
+	for (i = 0; i < count; i++)
+		LOCATIONS_NULL_ARG_CHECK(bounds[i]);
 
-	if (ret != LOCATION_ERROR_NONE) {
-		return __convert_error_code(ret, (char *)__FUNCTION__);
+	location_manager_s *handle = (location_manager_s *) manager;
+	guint first = handle->boundaries->len;
+	int ret = LOCATIONS_ERROR_NONE;
+
+	/* The copies are appended as they are added, so a failure rolls back exactly what was added */
+	for (i = 0; i < count; i++) {
+		location_bounds_s *copy = _location_bounds_clone((location_bounds_s *) bounds[i]);
+		if (copy == NULL) {
+			LOGE("[%s] LOCATIONS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to copy bounds", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+			ret = LOCATIONS_ERROR_OUT_OF_MEMORY;
+			break;
+		}
+		ret = __add_boundary_copy(handle, copy);
+		if (ret != LOCATIONS_ERROR_NONE) {
+			location_bounds_destroy((location_bounds_h) copy);
+			break;
+		}
+		g_ptr_array_add(handle->boundaries, copy);
 	}
-	return LOCATIONS_ERROR_NONE;
+
+	if (ret != LOCATIONS_ERROR_NONE)
+		__truncate_boundaries(handle, first);
+	return ret;
 }
 
 int location_manager_remove_boundary(location_manager_h manager, const location_bounds_h bounds)
 {
 	LOCATIONS_NULL_ARG_CHECK(manager);
 	LOCATIONS_NULL_ARG_CHECK(bounds);
+	return location_manager_remove_boundaries(manager, &bounds, 1);
+}
 
-	location_manager_s *handle = (location_manager_s *) manager;
-	int ret = location_boundary_remove(handle->object, (LocationBoundary*)bounds);
+int location_manager_remove_boundaries(location_manager_h manager, const location_bounds_h *bounds, int count)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(bounds);
+	LOCATIONS_CHECK_CONDITION(count > 0, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	int i;
+	for (i = 0; i < count; i++)
+		LOCATIONS_NULL_ARG_CHECK(bounds[i]);
 
-	if (ret != LOCATION_ERROR_NONE) {
-		return __convert_error_code(ret, (char *)__FUNCTION__);
+	location_manager_s *handle = (location_manager_s *) manager;
+	for (i = 0; i < count; i++) {
+		LocationBoundary *boundary = _location_bounds_get_boundary((location_bounds_s *) bounds[i]);
+		if (boundary == NULL) {
+			LOGE("[%s] LOCATIONS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to create boundary", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+			return LOCATIONS_ERROR_OUT_OF_MEMORY;
+		}
+		int ret = location_boundary_remove(handle->object, boundary);
+		if (ret != LOCATION_ERROR_NONE) {
+			return __convert_error_code(ret, (char *)__FUNCTION__);
+		}
+		__remove_boundary_copy(handle, (location_bounds_s *) bounds[i]);
 	}
 	return LOCATIONS_ERROR_NONE;
 }
 
-int location_manager_foreach_boundary(location_manager_h manager, location_bounds_cb callback, void *user_data)
+int location_manager_replace_boundaries(location_manager_h manager, const location_bounds_h *bounds, int count)
 {
 	LOCATIONS_NULL_ARG_CHECK(manager);
-	LOCATIONS_NULL_ARG_CHECK(callback);
+	LOCATIONS_CHECK_CONDITION(count >= 0, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(count == 0 || bounds != NULL, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	int i;
+	for (i = 0; i < count; i++)
+		LOCATIONS_NULL_ARG_CHECK(bounds[i]);
 
 	location_manager_s *handle = (location_manager_s *) manager;
-	handle->user_cb[_LOCATIONS_EVENT_TYPE_FOREACH_BOUNDS] = callback;
-	handle->user_data[_LOCATIONS_EVENT_TYPE_FOREACH_BOUNDS] = user_data;
-	handle->is_continue_foreach_bounds = TRUE;
-	int ret = location_boundary_foreach(handle->object, __foreach_boundary, handle);
-	if (ret != LOCATION_ERROR_NONE) {
-		return __convert_error_code(ret, (char *)__FUNCTION__);
+	guint old_count = handle->boundaries->len;
+	bool *keep = (bool *) calloc(old_count + 1, sizeof(bool));
+	location_bounds_h *added = (location_bounds_h *) malloc(sizeof(location_bounds_h) * (count + 1));
+	if (keep == NULL || added == NULL) {
+		LOGE("[%s] LOCATIONS_ERROR_OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+		free(keep);
+		free(added);
+		return LOCATIONS_ERROR_OUT_OF_MEMORY;
+	}
+
+	/* A bounds equal to one already added keeps its copy, the service never holds both at once */
+	int added_count = 0;
+	guint j;
+	for (i = 0; i < count; i++) {
+		for (j = 0; j < old_count; j++) {
+			if (!keep[j] && _location_bounds_equals((location_bounds_s *) g_ptr_array_index(handle->boundaries, j), (location_bounds_s *) bounds[i]))
+				break;
+		}
+		if (j < old_count)
+			keep[j] = TRUE;
+		else
+			added[added_count++] = bounds[i];
+	}
+
+	/* The new bounds first, so that a failure leaves the old ones untouched */
+	int ret = LOCATIONS_ERROR_NONE;
+	if (added_count > 0)
+		ret = location_manager_add_boundaries(manager, added, added_count);
+	free(added);
+	if (ret != LOCATIONS_ERROR_NONE) {
+		free(keep);
+		return ret;
+	}
+
+	/* Then the old ones, put back if one of them cannot be removed */
+	for (j = old_count; j-- > 0; ) {
+		if (keep[j])
+			continue;
+		LocationBoundary *boundary = _location_bounds_get_boundary((location_bounds_s *) g_ptr_array_index(handle->boundaries, j));
+		int err = location_boundary_remove(handle->object, boundary);
+		if (err == LOCATION_ERROR_NONE)
+			continue;
+
+		ret = __convert_error_code(err, (char *)__FUNCTION__);
+		guint k;
+		for (k = j + 1; k < old_count; k++) {
+			if (!keep[k] && location_boundary_add(handle->object, _location_bounds_get_boundary((location_bounds_s *) g_ptr_array_index(handle->boundaries, k))) != LOCATION_ERROR_NONE)
+				LOGE("[%s] fail to restore bounds %p", __FUNCTION__, g_ptr_array_index(handle->boundaries, k));
+		}
+		__truncate_boundaries(handle, old_count);
+		free(keep);
+		return ret;
+	}
+
+	for (j = old_count; j-- > 0; ) {
+		if (!keep[j])
+			location_bounds_destroy((location_bounds_h) g_ptr_array_remove_index(handle->boundaries, j));
+	}
+	free(keep);
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_foreach_boundary(location_manager_h manager, location_bounds_cb callback, void *user_data)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(callback);
+
+	/* The registered copies are lent to the callback as they are, nothing is created per bounds */
+	location_manager_s *handle = (location_manager_s *) manager;
+	guint i;
+	for (i = 0; i < handle->boundaries->len; i++) {
+		if (!callback((location_bounds_h) g_ptr_array_index(handle->boundaries, i), user_data)) {
+			LOGI("[%s] User quit the loop ", __FUNCTION__);
+			break;
+		}
 	}
 	return LOCATIONS_ERROR_NONE;
 }
@@ -437,6 +1117,16 @@ int location_manager_get_position(location_manager_h manager, double *altitude,
 	LOCATIONS_NULL_ARG_CHECK(timestamp);
 
 	location_manager_s *handle = (location_manager_s *) manager;
+
+	if (handle->is_fix_cached) {
+		_location_latest_s latest;
+		__latest_read(handle, &latest);
+		if (latest.has_position) {
+			__get_cached_position(&latest.fix, altitude, latitude, longitude, timestamp);
+			return LOCATIONS_ERROR_NONE;
+		}
+	}
+
 	int ret;
 	LocationPosition *pos = NULL;
 	LocationAccuracy *acc = NULL;
@@ -473,6 +1163,19 @@ int location_manager_get_velocity(location_manager_h manager, double *climb, dou
 	LOCATIONS_NULL_ARG_CHECK(timestamp);
 
 	location_manager_s *handle = (location_manager_s *) manager;
+
+	if (handle->is_fix_cached) {
+		_location_latest_s latest;
+		__latest_read(handle, &latest);
+		if (latest.has_velocity) {
+			*climb = latest.fix.climb;
+			*direction = latest.fix.direction;
+			*speed = latest.fix.speed;
+			*timestamp = latest.velocity_time.timestamp;
+			return LOCATIONS_ERROR_NONE;
+		}
+	}
+
 	int ret;
 	LocationVelocity *vel = NULL;
 	LocationAccuracy *acc = NULL;
@@ -499,6 +1202,17 @@ int location_manager_get_accuracy(location_manager_h manager, location_accuracy_
 	LOCATIONS_NULL_ARG_CHECK(vertical);
 	location_manager_s *handle = (location_manager_s *) manager;
 
+	if (handle->is_fix_cached) {
+		_location_latest_s latest;
+		__latest_read(handle, &latest);
+		if (latest.has_position) {
+			*level = latest.fix.level;
+			*horizontal = latest.fix.horizontal_accuracy;
+			*vertical = latest.fix.vertical_accuracy;
+			return LOCATIONS_ERROR_NONE;
+		}
+	}
+
 	int ret;
 	LocationPosition *pos = NULL;
 	LocationAccuracy *acc = NULL;
@@ -605,13 +1319,195 @@ int location_manager_get_last_accuracy(location_manager_h manager, location_accu
 	return LOCATIONS_ERROR_NONE;
 }
 
+int location_manager_set_fix_cache_enabled(location_manager_h manager, bool enable)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	location_manager_s *handle = (location_manager_s *) manager;
+	handle->is_fix_cached = enable;
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_get_fix(location_manager_h manager, location_fix_s *fix)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(fix);
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	_location_latest_s latest;
+	__latest_read(handle, &latest);
+	if (handle->is_fix_cached && latest.has_position) {
+		*fix = latest.fix;
+		return LOCATIONS_ERROR_NONE;
+	}
+
+	int ret;
+	LocationPosition *pos = NULL;
+	LocationAccuracy *acc = NULL;
+	ret = location_get_position(handle->object, &pos, &acc);
+	if (ret != LOCATION_ERROR_NONE) {
+		return __convert_error_code(ret, (char *)__FUNCTION__);
+	}
+
+	/* Velocity and satellites come from the updates already delivered in-process, not from more queries. */
+	*fix = latest.fix;
+	__fill_fix_position(fix, pos, acc);
+	fix->realtime_ns = __get_clock_ns(CLOCK_REALTIME);
+	fix->monotonic_ns = __get_clock_ns(CLOCK_MONOTONIC);
+	location_position_free(pos);
+	location_accuracy_free(acc);
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_set_smoothing_enabled(location_manager_h manager, bool enable, double acceleration)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_CHECK_CONDITION(!enable || (acceleration > 0
+				  && acceleration <= 100), LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	__latest_write_begin(handle);
+	_location_kalman_reset(&handle->kalman, acceleration);
+	handle->latest.has_smoothed = FALSE;
+	handle->is_smoothing = enable;
+	__latest_write_end(handle);
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_get_smoothed_fix(location_manager_h manager, location_fix_s *fix)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(fix);
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	_location_latest_s latest;
+	__latest_read(handle, &latest);
+	if (!latest.has_smoothed) {
+		LOGE("[%s] LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE(0x%08x) : no smoothed fix yet", __FUNCTION__,
+		     LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE);
+		return LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE;
+	}
+	*fix = latest.smoothed;
+	return LOCATIONS_ERROR_NONE;
+}
+
+/* Moves a position along the great circle of the given direction (degrees from the north) */
+static void __project_position(double *latitude, double *longitude, double direction, double distance)
+{
+	double angle = distance / LOCATIONS_EARTH_RADIUS_MEAN;
+	double heading = LOCATIONS_DEG_TO_RAD(direction);
+	double lat = LOCATIONS_DEG_TO_RAD(*latitude);
+	double lon = LOCATIONS_DEG_TO_RAD(*longitude);
+	double sin_lat = sin(lat), cos_lat = cos(lat);
+	double sin_angle = sin(angle), cos_angle = cos(angle);
+
+	double sin_lat2 = sin_lat * cos_angle + cos_lat * sin_angle * cos(heading);
+	double lat2 = asin(CLAMP(sin_lat2, -1, 1));
+	double lon2 = lon + atan2(sin(heading) * sin_angle * cos_lat, cos_angle - sin_lat * sin_lat2);
+
+	*latitude = lat2 * 180 / M_PI;
+	*longitude = remainder(lon2 * 180 / M_PI, 360);
+}
+
+int location_manager_predict_position(location_manager_h manager, double offset, double *altitude, double *latitude, double *longitude)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(altitude);
+	LOCATIONS_NULL_ARG_CHECK(latitude);
+	LOCATIONS_NULL_ARG_CHECK(longitude);
+	LOCATIONS_CHECK_CONDITION(offset >= -3600
+				  && offset <= 3600, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	_location_latest_s latest;
+	__latest_read(handle, &latest);
+	if (!latest.has_position || latest.fix.status == LOCATIONS_FIX_NONE) {
+		LOGE("[%s] LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE(0x%08x) : no position yet", __FUNCTION__,
+		     LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE);
+		return LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE;
+	}
+
+	/* The smoothed fix carries a filtered velocity, prefer it */
+	const location_fix_s *fix = latest.has_smoothed ? &latest.smoothed : &latest.fix;
+	gint64 time = latest.has_smoothed ? latest.smoothed_time : latest.position_time.monotonic_ns / 1000;
+	bool has_velocity = latest.has_smoothed || latest.has_velocity;
+	double dt = (__get_clock_ns(CLOCK_MONOTONIC) / 1000 - time) / 1000000.0 + offset;
+
+	*latitude = fix->latitude;
+	*longitude = fix->longitude;
+	*altitude = (fix->status == LOCATIONS_FIX_3D) ? fix->altitude : -1;
+	if (has_velocity) {
+		/* speed and climb are in km/h */
+		__project_position(latitude, longitude, fix->direction, fix->speed / 3.6 * dt);
+		if (fix->status == LOCATIONS_FIX_3D)
+			*altitude += fix->climb / 3.6 * dt;
+	}
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_get_history(location_manager_h manager, location_fix_s *fixes, int max_count, int *count)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(fixes);
+	LOCATIONS_NULL_ARG_CHECK(count);
+	LOCATIONS_CHECK_CONDITION(max_count >= 0, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	pthread_mutex_lock(&handle->history_lock);
+	int copied = MIN(max_count, handle->history_count);
+	__history_copy(handle, handle->history_count - copied, copied, fixes);
+	pthread_mutex_unlock(&handle->history_lock);
+
+	*count = copied;
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_get_history_since(location_manager_h manager, time_t since, location_fix_s *fixes, int max_count, int *count)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(fixes);
+	LOCATIONS_NULL_ARG_CHECK(count);
+	LOCATIONS_CHECK_CONDITION(max_count >= 0, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	pthread_mutex_lock(&handle->history_lock);
+	/* Fixes are recorded in delivery order, so the first one after since is found by bisection. */
+	int low = 0;
+	int high = handle->history_count;
+	while (low < high) {
+		int mid = (low + high) / 2;
+		if (handle->history[__history_slot(handle, mid)].timestamp > since)
+			high = mid;
+		else
+			low = mid + 1;
+	}
+	int copied = MIN(max_count, handle->history_count - low);
+	__history_copy(handle, low, copied, fixes);
+	pthread_mutex_unlock(&handle->history_lock);
+
+	*count = copied;
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_clear_history(location_manager_h manager)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	pthread_mutex_lock(&handle->history_lock);
+	handle->history_head = 0;
+	handle->history_count = 0;
+	pthread_mutex_unlock(&handle->history_lock);
+	return LOCATIONS_ERROR_NONE;
+}
+
 int location_manager_set_position_updated_cb(location_manager_h manager, location_position_updated_cb callback, int interval, void *user_data)
 {
 	LOCATIONS_CHECK_CONDITION(interval >= 1
 				  && interval <= 120, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
 	LOCATIONS_NULL_ARG_CHECK(manager);
 	location_manager_s *handle = (location_manager_s *) manager;
-	g_object_set(handle->object, "pos-interval", interval, NULL);
+	__set_interval(handle, _LOCATION_INTERVAL_POSITION, "pos-interval", interval);
+	handle->has_reported = FALSE;
 	return __set_callback(_LOCATIONS_EVENT_TYPE_POSITION, manager, callback, user_data);
 }
 
@@ -620,13 +1516,101 @@ int location_manager_unset_position_updated_cb(location_manager_h manager)
 	return __unset_callback(_LOCATIONS_EVENT_TYPE_POSITION, manager);
 }
 
+int location_manager_set_smoothed_updated_cb(location_manager_h manager, location_smoothed_updated_cb callback, int interval, void *user_data)
+{
+	LOCATIONS_CHECK_CONDITION(interval >= 1
+				  && interval <= 120, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	location_manager_s *handle = (location_manager_s *) manager;
+	__set_interval(handle, _LOCATION_INTERVAL_POSITION, "pos-interval", interval);
+	return __set_callback(_LOCATIONS_EVENT_TYPE_SMOOTHED, manager, callback, user_data);
+}
+
+int location_manager_unset_smoothed_updated_cb(location_manager_h manager)
+{
+	return __unset_callback(_LOCATIONS_EVENT_TYPE_SMOOTHED, manager);
+}
+
+int location_manager_set_position_distance_filter(location_manager_h manager, double distance)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_CHECK_CONDITION(distance >= 0
+				  && distance <= LOCATIONS_EARTH_RADIUS_MEAN * M_PI, LOCATIONS_ERROR_INVALID_PARAMETER,
+				  "LOCATIONS_ERROR_INVALID_PARAMETER");
+	location_manager_s *handle = (location_manager_s *) manager;
+	double angle = distance / LOCATIONS_EARTH_RADIUS_MEAN;
+	handle->filter_square = angle * angle;
+	handle->has_reported = FALSE;
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_set_batch_updated_cb(location_manager_h manager, location_batch_updated_cb callback, int interval, int batch_count,
+					  int batch_period, void *user_data)
+{
+	LOCATIONS_CHECK_CONDITION(interval >= 1
+				  && interval <= 120, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(batch_count >= 1
+				  && batch_count <= LOCATION_MANAGER_BATCH_CAPACITY, LOCATIONS_ERROR_INVALID_PARAMETER,
+				  "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(batch_period >= 0
+				  && batch_period <= 3600, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(callback);
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	/* Fixes pending under the previous settings go to the previous callback */
+	__batch_flush(handle);
+	handle->batch_max_count = batch_count;
+	handle->batch_period = batch_period;
+	__set_interval(handle, _LOCATION_INTERVAL_POSITION, "pos-interval", interval);
+	return __set_callback(_LOCATIONS_EVENT_TYPE_BATCH, manager, callback, user_data);
+}
+
+int location_manager_unset_batch_updated_cb(location_manager_h manager)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	__batch_discard((location_manager_s *) manager);
+	return __unset_callback(_LOCATIONS_EVENT_TYPE_BATCH, manager);
+}
+
+int location_manager_set_position_updated_ns_cb(location_manager_h manager, location_position_updated_ns_cb callback, int interval, void *user_data)
+{
+	LOCATIONS_CHECK_CONDITION(interval >= 1
+				  && interval <= 120, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	location_manager_s *handle = (location_manager_s *) manager;
+	__set_interval(handle, _LOCATION_INTERVAL_POSITION, "pos-interval", interval);
+	handle->has_reported = FALSE;
+	return __set_callback(_LOCATIONS_EVENT_TYPE_POSITION_NS, manager, callback, user_data);
+}
+
+int location_manager_unset_position_updated_ns_cb(location_manager_h manager)
+{
+	return __unset_callback(_LOCATIONS_EVENT_TYPE_POSITION_NS, manager);
+}
+
+int location_manager_set_velocity_updated_ns_cb(location_manager_h manager, location_velocity_updated_ns_cb callback, int interval, void *user_data)
+{
+	LOCATIONS_CHECK_CONDITION(interval >= 1
+				  && interval <= 120, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	location_manager_s *handle = (location_manager_s *) manager;
+	__set_interval(handle, _LOCATION_INTERVAL_VELOCITY, "vel-interval", interval);
+	return __set_callback(_LOCATIONS_EVENT_TYPE_VELOCITY_NS, manager, callback, user_data);
+}
+
+int location_manager_unset_velocity_updated_ns_cb(location_manager_h manager)
+{
+	return __unset_callback(_LOCATIONS_EVENT_TYPE_VELOCITY_NS, manager);
+}
+
 int location_manager_set_velocity_updated_cb(location_manager_h manager, location_velocity_updated_cb callback, int interval, void *user_data)
 {
 	LOCATIONS_CHECK_CONDITION(interval >= 1
 				  && interval <= 120, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
 	LOCATIONS_NULL_ARG_CHECK(manager);
 	location_manager_s *handle = (location_manager_s *) manager;
-	g_object_set(handle->object, "vel-interval", interval, NULL);
+	__set_interval(handle, _LOCATION_INTERVAL_VELOCITY, "vel-interval", interval);
 	return __set_callback(_LOCATIONS_EVENT_TYPE_VELOCITY, manager, callback, user_data);
 }
 
@@ -656,6 +1640,229 @@ int location_manager_unset_zone_changed_cb(location_manager_h manager)
 	return __unset_callback(_LOCATIONS_EVENT_TYPE_BOUNDARY, manager);
 }
 
+int location_manager_add_geofence(location_manager_h manager, location_bounds_h bounds)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(bounds);
+	return _location_geofence_add((location_manager_s *) manager, (location_bounds_s *) bounds);
+}
+
+int location_manager_remove_geofence(location_manager_h manager, location_bounds_h bounds)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(bounds);
+	return _location_geofence_remove((location_manager_s *) manager, (location_bounds_s *) bounds);
+}
+
+int location_manager_set_geofence_event_cb(location_manager_h manager, location_geofence_event_cb callback, double buffer, int dwell_time,
+					   void *user_data)
+{
+	LOCATIONS_CHECK_CONDITION(buffer >= 0
+				  && buffer <= 10000, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(dwell_time >= 0
+				  && dwell_time <= 86400, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(callback);
+	int ret = _location_geofence_reset((location_manager_s *) manager, buffer, dwell_time);
+	if (ret != LOCATIONS_ERROR_NONE)
+		return ret;
+	return __set_callback(_LOCATIONS_EVENT_TYPE_GEOFENCE, manager, callback, user_data);
+}
+
+int location_manager_unset_geofence_event_cb(location_manager_h manager)
+{
+	return __unset_callback(_LOCATIONS_EVENT_TYPE_GEOFENCE, manager);
+}
+
+int location_manager_set_zone_changed_ns_cb(location_manager_h manager, location_zone_changed_ns_cb callback, void *user_data)
+{
+	return __set_callback(_LOCATIONS_EVENT_TYPE_BOUNDARY_NS, manager, callback, user_data);
+}
+
+int location_manager_unset_zone_changed_ns_cb(location_manager_h manager)
+{
+	return __unset_callback(_LOCATIONS_EVENT_TYPE_BOUNDARY_NS, manager);
+}
+
+static int __get_last_time(location_manager_h manager, int which, location_timestamp_s *time, const char *func)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(time);
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	_location_latest_s latest;
+	__latest_read(handle, &latest);
+	bool has_time = (which == POSITION_UPDATED) ? latest.has_position
+	    : (which == VELOCITY_UPDATED) ? latest.has_velocity : latest.has_satellite;
+	if (!has_time) {
+		LOGE("[%s] LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE(0x%08x) : no update received yet", func, LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE);
+		return LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE;
+	}
+	*time = (which == POSITION_UPDATED) ? latest.position_time
+	    : (which == VELOCITY_UPDATED) ? latest.velocity_time : latest.satellite_time;
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_get_last_position_time(location_manager_h manager, location_timestamp_s *time)
+{
+	return __get_last_time(manager, POSITION_UPDATED, time, __FUNCTION__);
+}
+
+int location_manager_get_last_velocity_time(location_manager_h manager, location_timestamp_s *time)
+{
+	return __get_last_time(manager, VELOCITY_UPDATED, time, __FUNCTION__);
+}
+
+static int __add_listener(_location_event_e type, location_manager_h manager, const void *callback, void *user_data, int *listener_id)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(callback);
+	LOCATIONS_NULL_ARG_CHECK(listener_id);
+	return _location_listener_add((location_manager_s *) manager, type, callback, user_data, listener_id);
+}
+
+int location_manager_add_position_updated_listener(location_manager_h manager, location_position_updated_cb callback, void *user_data, int *listener_id)
+{
+	return __add_listener(_LOCATIONS_EVENT_TYPE_POSITION, manager, callback, user_data, listener_id);
+}
+
+int location_manager_add_velocity_updated_listener(location_manager_h manager, location_velocity_updated_cb callback, void *user_data, int *listener_id)
+{
+	return __add_listener(_LOCATIONS_EVENT_TYPE_VELOCITY, manager, callback, user_data, listener_id);
+}
+
+int location_manager_add_service_state_changed_listener(location_manager_h manager, location_service_state_changed_cb callback, void *user_data,
+							int *listener_id)
+{
+	return __add_listener(_LOCATIONS_EVENT_TYPE_SERVICE_STATE, manager, callback, user_data, listener_id);
+}
+
+int location_manager_add_zone_changed_listener(location_manager_h manager, location_zone_changed_cb callback, void *user_data, int *listener_id)
+{
+	return __add_listener(_LOCATIONS_EVENT_TYPE_BOUNDARY, manager, callback, user_data, listener_id);
+}
+
+int location_manager_remove_listener(location_manager_h manager, int listener_id)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	return _location_listener_remove((location_manager_s *) manager, listener_id);
+}
+
+int location_manager_set_dispatch_thread_enabled(location_manager_h manager, bool enable, int queue_size, location_dispatch_overflow_e overflow)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_CHECK_CONDITION(!enable || (queue_size >= 1 && queue_size <= LOCATION_MANAGER_DISPATCH_QUEUE_MAX),
+				  LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(!enable || overflow == LOCATIONS_DISPATCH_OVERFLOW_DROP_OLDEST
+				  || overflow == LOCATIONS_DISPATCH_OVERFLOW_COALESCE, LOCATIONS_ERROR_INVALID_PARAMETER,
+				  "LOCATIONS_ERROR_INVALID_PARAMETER");
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	if (handle->dispatch) {
+		/* The dispatch thread cannot wait for itself */
+		LOCATIONS_CHECK_CONDITION(!_location_dispatch_is_current_thread(handle->dispatch), LOCATIONS_ERROR_INVALID_PARAMETER,
+					  "LOCATIONS_ERROR_INVALID_PARAMETER");
+		_location_dispatch_s *dispatch = handle->dispatch;
+		handle->dispatch = NULL;
+		_location_dispatch_destroy(dispatch);
+	}
+	if (enable) {
+		handle->dispatch = _location_dispatch_new(handle, queue_size, overflow);
+		if (handle->dispatch == NULL) {
+			LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+			return LOCATIONS_ERROR_OUT_OF_MEMORY;
+		}
+	}
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_get_dispatch_dropped_count(location_manager_h manager, unsigned int *dropped, unsigned int *coalesced)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(dropped);
+	LOCATIONS_NULL_ARG_CHECK(coalesced);
+	location_manager_s *handle = (location_manager_s *) manager;
+	*dropped = __atomic_load_n(&handle->dispatch_dropped, __ATOMIC_RELAXED);
+	*coalesced = __atomic_load_n(&handle->dispatch_coalesced, __ATOMIC_RELAXED);
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_set_duty_cycle(location_manager_h manager, location_duty_cycle_policy_e policy, int min_interval, int max_interval)
+{
+	LOCATIONS_CHECK_CONDITION(policy >= LOCATIONS_DUTY_CYCLE_HIGH_ACCURACY
+				  && policy <= LOCATIONS_DUTY_CYCLE_POWER_SAVING, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(min_interval >= 1
+				  && min_interval <= 120, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(max_interval >= min_interval
+				  && max_interval <= LOCATION_MANAGER_DUTY_CYCLE_INTERVAL_MAX, LOCATIONS_ERROR_INVALID_PARAMETER,
+				  "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	location_manager_s *handle = (location_manager_s *) manager;
+	if (handle->session) {
+		LOGE("[%s] LOCATIONS_ERROR_INVALID_PARAMETER(0x%08x) : the service of a shared manager is not its own", __FUNCTION__,
+		     LOCATIONS_ERROR_INVALID_PARAMETER);
+		return LOCATIONS_ERROR_INVALID_PARAMETER;
+	}
+
+	if (handle->duty_cycle == NULL) {
+		handle->duty_cycle = (_location_duty_cycle_s *) malloc(sizeof(_location_duty_cycle_s));
+		if (handle->duty_cycle == NULL) {
+			LOGE("[%s] OUT_OF_MEMORY(0x%08x)", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+			return LOCATIONS_ERROR_OUT_OF_MEMORY;
+		}
+		memset(handle->duty_cycle, 0, sizeof(_location_duty_cycle_s));
+		handle->duty_cycle->wake_ns = __get_clock_ns(CLOCK_MONOTONIC);
+	}
+	_location_duty_cycle_reset(handle->duty_cycle, policy, min_interval, max_interval);
+	if (handle->duty_cycle->is_sleeping) {
+		/* Start over from the new shortest interval */
+		g_source_remove(handle->duty_cycle->timer);
+		handle->duty_cycle->timer = 0;
+		int ret = __duty_cycle_restart(handle);
+		if (ret != LOCATION_ERROR_NONE)
+			return __convert_error_code(ret, (char *)__FUNCTION__);
+	} else {
+		__duty_cycle_apply(handle, min_interval);
+	}
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_unset_duty_cycle(location_manager_h manager)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	location_manager_s *handle = (location_manager_s *) manager;
+	_location_duty_cycle_s *duty = handle->duty_cycle;
+	if (duty == NULL)
+		return LOCATIONS_ERROR_NONE;
+
+	if (duty->is_sleeping) {
+		/* The duty cycle stays until the service runs again, it keeps retrying meanwhile */
+		g_source_remove(duty->timer);
+		duty->timer = 0;
+		int ret = __duty_cycle_restart(handle);
+		if (ret != LOCATION_ERROR_NONE)
+			return __convert_error_code(ret, (char *)__FUNCTION__);
+	}
+	__duty_cycle_cancel(handle);
+	handle->duty_cycle = NULL;
+	free(duty);
+	/* 1 second is the default of the service */
+	g_object_set(handle->object, "pos-interval", handle->intervals[_LOCATION_INTERVAL_POSITION] > 0
+		     ? handle->intervals[_LOCATION_INTERVAL_POSITION] : 1, NULL);
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_get_duty_cycle_interval(location_manager_h manager, int *interval)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(interval);
+	location_manager_s *handle = (location_manager_s *) manager;
+	LOCATIONS_CHECK_CONDITION(handle->duty_cycle != NULL, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+
+	*interval = __atomic_load_n(&handle->duty_cycle->interval, __ATOMIC_RELAXED);
+	return LOCATIONS_ERROR_NONE;
+}
+
 int location_manager_get_distance(double start_latitude, double start_longitude, double end_latitude, double end_longitude, double *distance)
 {
 	LOCATIONS_NULL_ARG_CHECK(distance);
@@ -669,8 +1876,18 @@ int location_manager_get_distance(double start_latitude, double start_longitude,
 
 	LocationPosition *start = location_position_new (0, start_latitude, start_longitude, 0, LOCATION_STATUS_2D_FIX);
 	LocationPosition *end = location_position_new (0, end_latitude, end_longitude, 0, LOCATION_STATUS_2D_FIX);
+	if (start == NULL || end == NULL) {
+		if (start)
+			location_position_free(start);
+		if (end)
+			location_position_free(end);
+		LOGE("[%s] LOCATIONS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to location_position_new", __FUNCTION__, LOCATIONS_ERROR_OUT_OF_MEMORY);
+		return LOCATIONS_ERROR_OUT_OF_MEMORY;
+	}
 
 	ret = location_get_distance (start, end, &u_distance);
+	location_position_free(start);
+	location_position_free(end);
 	if (ret != LOCATION_ERROR_NONE) {
 		return __convert_error_code(ret, (char *)__FUNCTION__);
 	}
@@ -680,6 +1897,55 @@ int location_manager_get_distance(double start_latitude, double start_longitude,
 	return LOCATIONS_ERROR_NONE;
 }
 
+static bool __is_valid_coords(location_coords_s coords)
+{
+	return coords.latitude >= -90 && coords.latitude <= 90 && coords.longitude >= -180 && coords.longitude <= 180;
+}
+
+int location_manager_get_distances(const location_coords_s *from, const location_coords_s *to, int n, double *out)
+{
+	LOCATIONS_NULL_ARG_CHECK(from);
+	LOCATIONS_NULL_ARG_CHECK(to);
+	LOCATIONS_NULL_ARG_CHECK(out);
+	LOCATIONS_CHECK_CONDITION(n>=0,LOCATIONS_ERROR_INVALID_PARAMETER,"LOCATIONS_ERROR_INVALID_PARAMETER");
+
+	int i;
+	for (i = 0; i < n; i++) {
+		LOCATIONS_CHECK_CONDITION(__is_valid_coords(from[i]) && __is_valid_coords(to[i]),LOCATIONS_ERROR_INVALID_PARAMETER,"LOCATIONS_ERROR_INVALID_PARAMETER");
+	}
+
+	for (i = 0; i < n; i++) {
+		double lat1 = LOCATIONS_DEG_TO_RAD(from[i].latitude);
+		double lat2 = LOCATIONS_DEG_TO_RAD(to[i].latitude);
+		out[i] = LOCATIONS_EARTH_RADIUS_MEAN * _location_haversine_angle(lat1, LOCATIONS_DEG_TO_RAD(from[i].longitude), cos(lat1),
+										 lat2, LOCATIONS_DEG_TO_RAD(to[i].longitude), cos(lat2));
+	}
+	return LOCATIONS_ERROR_NONE;
+}
+
+int location_manager_get_distances_from(location_coords_s from, const location_coords_s *to, int n, double *out)
+{
+	LOCATIONS_NULL_ARG_CHECK(to);
+	LOCATIONS_NULL_ARG_CHECK(out);
+	LOCATIONS_CHECK_CONDITION(n>=0,LOCATIONS_ERROR_INVALID_PARAMETER,"LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_CHECK_CONDITION(__is_valid_coords(from),LOCATIONS_ERROR_INVALID_PARAMETER,"LOCATIONS_ERROR_INVALID_PARAMETER");
+
+	int i;
+	for (i = 0; i < n; i++) {
+		LOCATIONS_CHECK_CONDITION(__is_valid_coords(to[i]),LOCATIONS_ERROR_INVALID_PARAMETER,"LOCATIONS_ERROR_INVALID_PARAMETER");
+	}
+
+	/* The origin is converted once; each target costs one cosine and the haversine itself. */
+	double lat1 = LOCATIONS_DEG_TO_RAD(from.latitude);
+	double lon1 = LOCATIONS_DEG_TO_RAD(from.longitude);
+	double cos_lat1 = cos(lat1);
+	for (i = 0; i < n; i++) {
+		double lat2 = LOCATIONS_DEG_TO_RAD(to[i].latitude);
+		out[i] = LOCATIONS_EARTH_RADIUS_MEAN * _location_haversine_angle(lat1, lon1, cos_lat1, lat2, LOCATIONS_DEG_TO_RAD(to[i].longitude), cos(lat2));
+	}
+	return LOCATIONS_ERROR_NONE;
+}
+
 int location_manager_send_command(const char *cmd)
 {
 	LOCATIONS_NULL_ARG_CHECK(cmd);
@@ -697,43 +1963,81 @@ int location_manager_send_command(const char *cmd)
 // GPS Status & Satellites
 ////////////////////////////////////////
 
-int gps_status_get_nmea(location_manager_h manager, char **nmea)
+/* The NMEA data of the service, to be released with g_free() */
+static int __get_nmea_data(location_manager_s *handle, gchar **nmea_data, const char *func)
 {
-	LOCATIONS_NULL_ARG_CHECK(manager);
-	LOCATIONS_NULL_ARG_CHECK(nmea);
-	location_manager_s *handle = (location_manager_s *) manager;
-
 	if (handle->method == LOCATIONS_METHOD_HYBRID) {
 		LocationMethod _method = LOCATION_METHOD_NONE;
 		g_object_get(handle->object, "method", &_method, NULL);
 		if (_method != LOCATION_METHOD_GPS) {
-			LOGE("[%s] LOCATIONS_ERROR_INCORRECT_METHOD(0x%08x) : method - %d", __FUNCTION__,
+			LOGE("[%s] LOCATIONS_ERROR_INCORRECT_METHOD(0x%08x) : method - %d", func,
 			     LOCATIONS_ERROR_INCORRECT_METHOD, handle->method);
 			return LOCATIONS_ERROR_INCORRECT_METHOD;
 		}
 	} else if (handle->method != LOCATIONS_METHOD_GPS) {
-		LOGE("[%s] LOCATIONS_ERROR_INCORRECT_METHOD(0x%08x) : method - %d", __FUNCTION__,
+		LOGE("[%s] LOCATIONS_ERROR_INCORRECT_METHOD(0x%08x) : method - %d", func,
 		     LOCATIONS_ERROR_INCORRECT_METHOD, handle->method);
 		return LOCATIONS_ERROR_INCORRECT_METHOD;
 	}
-	gchar *nmea_data = NULL;
-	g_object_get(handle->object, "nmea", &nmea_data, NULL);
-	if (nmea_data == NULL) {
-		LOGE("[%s] LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE(0x%08x) : nmea data is NULL ", __FUNCTION__,
+	*nmea_data = NULL;
+	g_object_get(handle->object, "nmea", nmea_data, NULL);
+	if (*nmea_data == NULL) {
+		LOGE("[%s] LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE(0x%08x) : nmea data is NULL ", func,
 		     LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE);
 		return LOCATIONS_ERROR_SERVICE_NOT_AVAILABLE;
 	}
+	return LOCATIONS_ERROR_NONE;
+}
+
+int gps_status_get_nmea(location_manager_h manager, char **nmea)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(nmea);
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	gchar *nmea_data = NULL;
+	int ret = __get_nmea_data(handle, &nmea_data, __FUNCTION__);
+	if (ret != LOCATIONS_ERROR_NONE)
+		return ret;
 	*nmea = NULL;
 	*nmea = strdup(nmea_data);
 	if (*nmea == NULL) {
 		LOGE("[%s] LOCATIONS_ERROR_OUT_OF_MEMORY(0x%08x) : fail to strdup ", __FUNCTION__,
 		     LOCATIONS_ERROR_OUT_OF_MEMORY);
+		g_free(nmea_data);
 		return LOCATIONS_ERROR_OUT_OF_MEMORY;
 	}
 	g_free(nmea_data);
 	return LOCATIONS_ERROR_NONE;
 }
 
+int gps_status_foreach_nmea_sentence(location_manager_h manager, gps_status_nmea_sentence_cb callback, void *user_data)
+{
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	LOCATIONS_NULL_ARG_CHECK(callback);
+	location_manager_s *handle = (location_manager_s *) manager;
+
+	gchar *nmea_data = NULL;
+	int ret = __get_nmea_data(handle, &nmea_data, __FUNCTION__);
+	if (ret != LOCATIONS_ERROR_NONE)
+		return ret;
+
+	/* The sentences are lent from the buffer of the service, one per line */
+	const char *line = nmea_data;
+	while (*line) {
+		const char *end = strchr(line, '\n');
+		int length = end ? end - line : (int) strlen(line);
+		const char *next = end ? end + 1 : line + length;
+		if (length && line[length - 1] == '\r')
+			length--;
+		if (length && !callback(line, length, user_data))
+			break;
+		line = next;
+	}
+	g_free(nmea_data);
+	return LOCATIONS_ERROR_NONE;
+}
+
 int gps_status_get_satellite(location_manager_h manager, int *num_of_active, int *num_of_inview, time_t *timestamp)
 {
 	LOCATIONS_NULL_ARG_CHECK(manager);
@@ -769,10 +2073,35 @@ int gps_status_set_satellite_updated_cb(location_manager_h manager, gps_status_s
 				  && interval <= 120, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
 	LOCATIONS_NULL_ARG_CHECK(manager);
 	location_manager_s *handle = (location_manager_s *) manager;
-	g_object_set(handle->object, "sat-interval", interval, NULL);
+	__set_interval(handle, _LOCATION_INTERVAL_SATELLITE, "sat-interval", interval);
 	return __set_callback(_LOCATIONS_EVENT_TYPE_SATELLITE, manager, callback, user_data);
 }
 
+int gps_status_set_satellite_updated_ns_cb(location_manager_h manager, gps_status_satellite_updated_ns_cb callback, int interval, void *user_data)
+{
+	LOCATIONS_CHECK_CONDITION(interval >= 1
+				  && interval <= 120, LOCATIONS_ERROR_INVALID_PARAMETER, "LOCATIONS_ERROR_INVALID_PARAMETER");
+	LOCATIONS_NULL_ARG_CHECK(manager);
+	location_manager_s *handle = (location_manager_s *) manager;
+	__set_interval(handle, _LOCATION_INTERVAL_SATELLITE, "sat-interval", interval);
+	return __set_callback(_LOCATIONS_EVENT_TYPE_SATELLITE_NS, manager, callback, user_data);
+}
+
+int gps_status_unset_satellite_updated_ns_cb(location_manager_h manager)
+{
+	return __unset_callback(_LOCATIONS_EVENT_TYPE_SATELLITE_NS, manager);
+}
+
+int gps_status_add_satellite_updated_listener(location_manager_h manager, gps_status_satellite_updated_cb callback, void *user_data, int *listener_id)
+{
+	return __add_listener(_LOCATIONS_EVENT_TYPE_SATELLITE, manager, callback, user_data, listener_id);
+}
+
+int gps_status_get_last_satellite_time(location_manager_h manager, location_timestamp_s *time)
+{
+	return __get_last_time(manager, SATELLITE_UPDATED, time, __FUNCTION__);
+}
+
 int gps_status_unset_satellite_updated_cb(location_manager_h manager)
 {
 	return __unset_callback(_LOCATIONS_EVENT_TYPE_SATELLITE, manager);
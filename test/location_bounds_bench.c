@@ -0,0 +1,269 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License. 
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <glib.h>
+#include <math.h>
+#include <locations.h>
+#include <locations_private.h>
+
+#define BENCH_POINT_COUNT	100000
+#define BENCH_VERTEX_COUNT	100000
+#define BENCH_EDGE_TESTS	50000000
+
+static double __now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void __random_coords(location_coords_s *coords_list, int length, double lat_min, double lat_max, double lon_min, double lon_max)
+{
+	int i;
+	for (i = 0; i < length; i++) {
+		coords_list[i].latitude = lat_min + (lat_max - lat_min) * rand() / (double)RAND_MAX;
+		coords_list[i].longitude = lon_min + (lon_max - lon_min) * rand() / (double)RAND_MAX;
+	}
+}
+
+static void __bench_contains(const char *name, location_bounds_h bounds, const location_coords_s *coords_list, int length)
+{
+	int i;
+	int hit_loop = 0;
+	int hit_batch = 0;
+	bool *contained_list = malloc(sizeof(bool) * length);
+	if (contained_list == NULL) {
+		printf("[%s] out of memory\n", name);
+		return;
+	}
+
+	double start = __now();
+	for (i = 0; i < length; i++) {
+		if (location_bounds_contains_coordinates(bounds, coords_list[i]))
+			hit_loop++;
+	}
+	double loop_time = __now() - start;
+
+	start = __now();
+	int ret = location_bounds_contains_coordinates_batch(bounds, coords_list, length, contained_list);
+	double batch_time = __now() - start;
+	if (ret != LOCATION_BOUNDS_ERROR_NONE) {
+		printf("[%s] location_bounds_contains_coordinates_batch() failed : %d\n", name, ret);
+		free(contained_list);
+		return;
+	}
+	for (i = 0; i < length; i++) {
+		if (contained_list[i])
+			hit_batch++;
+	}
+
+	printf("[%s] %d points, per-point loop : %.1f ns/point, batch : %.1f ns/point, hits : %d / %d%s\n", name, length,
+	       loop_time * 1e9 / length, batch_time * 1e9 / length, hit_loop, hit_batch, hit_loop == hit_batch ? "" : " MISMATCH");
+	free(contained_list);
+}
+
+static void location_bounds_contains_bench(void)
+{
+	location_coords_s *coords_list = malloc(sizeof(location_coords_s) * BENCH_POINT_COUNT);
+	if (coords_list == NULL)
+		return;
+	__random_coords(coords_list, BENCH_POINT_COUNT, 36.0, 38.5, 126.0, 128.5);
+
+	location_coords_s center;
+	center.latitude = 37.258;
+	center.longitude = 127.056;
+	location_bounds_h bounds_circle;
+	if (location_bounds_create_circle(center, 30000, &bounds_circle) == LOCATION_BOUNDS_ERROR_NONE) {
+		__bench_contains("circle", bounds_circle, coords_list, BENCH_POINT_COUNT);
+		location_bounds_destroy(bounds_circle);
+	}
+
+	location_coords_s left_top;
+	location_coords_s right_bottom;
+	left_top.latitude = 37.8;
+	left_top.longitude = 126.5;
+	right_bottom.latitude = 37.0;
+	right_bottom.longitude = 127.5;
+	location_bounds_h bounds_rect;
+	if (location_bounds_create_rect(left_top, right_bottom, &bounds_rect) == LOCATION_BOUNDS_ERROR_NONE) {
+		__bench_contains("rect", bounds_rect, coords_list, BENCH_POINT_COUNT);
+		location_bounds_destroy(bounds_rect);
+	}
+
+	location_coords_s coord_list[4];
+	coord_list[0].latitude = 37.0;
+	coord_list[0].longitude = 126.5;
+	coord_list[1].latitude = 37.8;
+	coord_list[1].longitude = 126.8;
+	coord_list[2].latitude = 37.6;
+	coord_list[2].longitude = 127.6;
+	coord_list[3].latitude = 36.9;
+	coord_list[3].longitude = 127.2;
+	location_bounds_h bounds_poly;
+	if (location_bounds_create_polygon(coord_list, 4, &bounds_poly) == LOCATION_BOUNDS_ERROR_NONE) {
+		__bench_contains("polygon", bounds_poly, coords_list, BENCH_POINT_COUNT);
+		location_bounds_destroy(bounds_poly);
+	}
+
+	free(coords_list);
+}
+
+static bool __count_coords_cb(location_coords_s coords, void *user_data)
+{
+	(*(int *)user_data)++;
+	return TRUE;
+}
+
+static void location_bounds_polygon_bench(void)
+{
+	int i;
+	location_coords_s *coords_list = malloc(sizeof(location_coords_s) * BENCH_VERTEX_COUNT);
+	if (coords_list == NULL)
+		return;
+	for (i = 0; i < BENCH_VERTEX_COUNT; i++) {
+		double angle = 2 * M_PI * i / BENCH_VERTEX_COUNT;
+		coords_list[i].latitude = 37.258 + 0.5 * sin(angle);
+		coords_list[i].longitude = 127.056 + 0.5 * cos(angle);
+	}
+
+	location_bounds_h bounds_poly;
+	double start = __now();
+	int ret = location_bounds_create_polygon(coords_list, BENCH_VERTEX_COUNT, &bounds_poly);
+	double create_time = __now() - start;
+	if (ret != LOCATION_BOUNDS_ERROR_NONE) {
+		printf("location_bounds_create_polygon() failed : %d\n", ret);
+		free(coords_list);
+		return;
+	}
+
+	int count = 0;
+	start = __now();
+	location_bounds_foreach_polygon_coords(bounds_poly, __count_coords_cb, &count);
+	double foreach_time = __now() - start;
+
+	printf("[polygon %d vertices] create : %.1f ns/vertex, foreach : %.1f ns/vertex (%d visited)\n", BENCH_VERTEX_COUNT,
+	       create_time * 1e9 / BENCH_VERTEX_COUNT, foreach_time * 1e9 / BENCH_VERTEX_COUNT, count);
+	location_bounds_destroy(bounds_poly);
+	free(coords_list);
+}
+
+static const char *__kernel_name(_location_polygon_kernel_e kernel)
+{
+	switch (kernel) {
+	case _LOCATION_POLYGON_KERNEL_SCALAR:
+		return "scalar";
+	case _LOCATION_POLYGON_KERNEL_SSE2:
+		return "sse2";
+	case _LOCATION_POLYGON_KERNEL_AVX2:
+		return "avx2";
+	default:
+		return "auto";
+	}
+}
+
+static void __bench_polygon_kernels(int vertex_count)
+{
+	int i;
+	location_coords_s *vertex_list = malloc(sizeof(location_coords_s) * vertex_count);
+	if (vertex_list == NULL)
+		return;
+	/* Wavy ring so that a ray crosses more than two edges */
+	for (i = 0; i < vertex_count; i++) {
+		double angle = 2 * M_PI * i / vertex_count;
+		double radius = 0.5 + 0.1 * sin(angle * 37);
+		vertex_list[i].latitude = 37.258 + radius * sin(angle);
+		vertex_list[i].longitude = 127.056 + radius * cos(angle);
+	}
+
+	location_bounds_h bounds_poly;
+	if (location_bounds_create_polygon(vertex_list, vertex_count, &bounds_poly) != LOCATION_BOUNDS_ERROR_NONE) {
+		free(vertex_list);
+		return;
+	}
+
+	int point_count = BENCH_EDGE_TESTS / vertex_count;
+	location_coords_s *coords_list = malloc(sizeof(location_coords_s) * point_count);
+	if (coords_list == NULL) {
+		location_bounds_destroy(bounds_poly);
+		free(vertex_list);
+		return;
+	}
+	__random_coords(coords_list, point_count, 36.6, 37.9, 126.4, 127.7);
+
+	_location_polygon_kernel_e kernel;
+	for (kernel = _LOCATION_POLYGON_KERNEL_SCALAR; kernel <= _LOCATION_POLYGON_KERNEL_AVX2; kernel++) {
+		if (!_location_polygon_set_kernel(kernel)) {
+			printf("[polygon %d vertices] %s : not supported\n", vertex_count, __kernel_name(kernel));
+			continue;
+		}
+
+		int hit = 0;
+		double start = __now();
+		for (i = 0; i < point_count; i++) {
+			if (location_bounds_contains_coordinates(bounds_poly, coords_list[i]))
+				hit++;
+		}
+		double elapsed = __now() - start;
+		printf("[polygon %d vertices] %s : %.3f ns/vertex, %.1f us/point, hits : %d / %d\n", vertex_count,
+		       __kernel_name(kernel), elapsed * 1e9 / ((double)point_count * vertex_count), elapsed * 1e6 / point_count, hit,
+		       point_count);
+	}
+	_location_polygon_set_kernel(_LOCATION_POLYGON_KERNEL_AUTO);
+
+	int resolution;
+	for (resolution = 16; resolution <= 256; resolution *= 4) {
+		double start = __now();
+		if (location_bounds_prepare(bounds_poly, resolution) != LOCATION_BOUNDS_ERROR_NONE) {
+			printf("[polygon %d vertices] location_bounds_prepare(%d) failed\n", vertex_count, resolution);
+			break;
+		}
+		double prepare_time = __now() - start;
+
+		int hit = 0;
+		start = __now();
+		for (i = 0; i < point_count; i++) {
+			if (location_bounds_contains_coordinates(bounds_poly, coords_list[i]))
+				hit++;
+		}
+		double elapsed = __now() - start;
+		printf("[polygon %d vertices] prepared %dx%d : %.1f ms to prepare, %.1f ns/point, hits : %d / %d\n", vertex_count,
+		       resolution, resolution, prepare_time * 1e3, elapsed * 1e9 / point_count, hit, point_count);
+	}
+
+	free(coords_list);
+	location_bounds_destroy(bounds_poly);
+	free(vertex_list);
+}
+
+static void location_bounds_polygon_kernel_bench(void)
+{
+	__bench_polygon_kernels(1000);
+	__bench_polygon_kernels(10000);
+	__bench_polygon_kernels(100000);
+}
+
+int main(int argc, char **argv)
+{
+	srand(1);
+	location_bounds_contains_bench();
+	location_bounds_polygon_bench();
+	location_bounds_polygon_kernel_bench();
+	return 0;
+}
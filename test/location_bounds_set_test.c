@@ -0,0 +1,225 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdlib.h>
+#include <glib.h>
+#include "location_test_util.h"
+
+/*
+* Stress test of the bounds set. Random rects and circles go through the bulk load, thousands of
+* additions (splits) and removals (condensing, re-insertion), and after each round the tree is checked
+* for its invariants and the queries are compared with a brute force search.
+*/
+
+#define TEST_BOUNDS_COUNT	4000
+#define TEST_ROUNDS		6
+#define TEST_QUERY_COUNT	2000
+
+static double __random(double min, double max)
+{
+	return min + (max - min) * rand() / (double)RAND_MAX;
+}
+
+static location_bounds_h __random_bounds(void)
+{
+	location_bounds_h bounds = NULL;
+	location_coords_s center;
+	center.latitude = __random(36.0, 38.0);
+	center.longitude = __random(126.0, 128.0);
+	if (rand() % 2) {
+		location_bounds_create_circle(center, __random(100, 20000), &bounds);
+	} else {
+		location_coords_s left_top;
+		location_coords_s right_bottom;
+		double height = __random(0.001, 0.2);
+		double width = __random(0.001, 0.2);
+		left_top.latitude = center.latitude + height;
+		left_top.longitude = center.longitude - width;
+		right_bottom.latitude = center.latitude - height;
+		right_bottom.longitude = center.longitude + width;
+		location_bounds_create_rect(left_top, right_bottom, &bounds);
+	}
+	return bounds;
+}
+
+static bool __rect_covers(const _location_rect_s *outer, const _location_rect_s *inner)
+{
+	return outer->min_latitude <= inner->min_latitude && outer->max_latitude >= inner->max_latitude
+	    && outer->min_longitude <= inner->min_longitude && outer->max_longitude >= inner->max_longitude;
+}
+
+/* Returns the number of bounds under the node and checks the depth of its leaves */
+static int __check_node(const _location_bounds_set_node_s *node, const _location_bounds_set_node_s *parent, int depth, int *leaf_depth)
+{
+	int i;
+	int count = 0;
+	TEST_CHECK(node->parent == parent, "node %p : parent %p, expected %p", node, node->parent, parent);
+	TEST_CHECK(node->count <= _LOCATION_BOUNDS_SET_NODE_MAX, "node %p : %d entries", node, node->count);
+	TEST_CHECK(parent == NULL || node->count >= _LOCATION_BOUNDS_SET_NODE_MIN, "node %p : underfull, %d entries", node, node->count);
+
+	if (node->is_leaf) {
+		if (*leaf_depth < 0)
+			*leaf_depth = depth;
+		TEST_CHECK(*leaf_depth == depth, "leaf %p : depth %d, expected %d", node, depth, *leaf_depth);
+		for (i = 0; i < node->count; i++) {
+			const location_bounds_s *bounds = (const location_bounds_s *) node->child[i];
+			TEST_CHECK(__rect_covers(&node->rect[i], &bounds->bbox), "leaf %p : entry %d does not cover its bounds", node, i);
+		}
+		return node->count;
+	}
+
+	for (i = 0; i < node->count; i++) {
+		const _location_bounds_set_node_s *child = (const _location_bounds_set_node_s *) node->child[i];
+		int j;
+		for (j = 0; j < child->count; j++)
+			TEST_CHECK(__rect_covers(&node->rect[i], &child->rect[j]), "node %p : entry %d does not cover its child", node, i);
+		count += __check_node(child, node, depth + 1, leaf_depth);
+	}
+	return count;
+}
+
+static void __check_tree(const char *name, location_bounds_set_h set, int expected)
+{
+	location_bounds_set_s *handle = (location_bounds_set_s *) set;
+	int leaf_depth = -1;
+	int count = __check_node(handle->root, NULL, 0, &leaf_depth);
+	TEST_CHECK(count + (int) g_list_length(handle->pending) == expected, "[%s] %d bounds in the tree, expected %d", name, count, expected);
+
+	int reported = -1;
+	location_bounds_set_get_count(set, &reported);
+	TEST_CHECK(reported == expected, "[%s] location_bounds_set_get_count() : %d, expected %d", name, reported, expected);
+}
+
+static bool __collect_cb(location_bounds_h bounds, void *user_data)
+{
+	GHashTable *found = (GHashTable *) user_data;
+	if (g_hash_table_contains(found, bounds))
+		failures++;
+	g_hash_table_add(found, bounds);
+	return TRUE;
+}
+
+static void __check_queries(const char *name, location_bounds_set_h set, location_bounds_h *bounds_list, const bool *in_set, int length)
+{
+	int q;
+	int i;
+	int mismatches = 0;
+	GHashTable *found = g_hash_table_new(g_direct_hash, g_direct_equal);
+	for (q = 0; q < TEST_QUERY_COUNT; q++) {
+		location_coords_s coords;
+		coords.latitude = __random(35.8, 38.2);
+		coords.longitude = __random(125.8, 128.2);
+		g_hash_table_remove_all(found);
+		location_bounds_set_foreach_containing_bounds(set, coords, __collect_cb, found);
+
+		int expected = 0;
+		for (i = 0; i < length; i++) {
+			if (!in_set[i] || !location_bounds_contains_coordinates(bounds_list[i], coords))
+				continue;
+			expected++;
+			if (!g_hash_table_contains(found, bounds_list[i]))
+				mismatches++;
+		}
+		if ((int) g_hash_table_size(found) != expected)
+			mismatches++;
+	}
+	g_hash_table_destroy(found);
+	TEST_CHECK(mismatches == 0, "[%s] %d query mismatches against brute force", name, mismatches);
+}
+
+static void location_bounds_set_stress_test(void)
+{
+	int i;
+	int round;
+	location_bounds_h *bounds_list = malloc(sizeof(location_bounds_h) * TEST_BOUNDS_COUNT);
+	bool *in_set = malloc(sizeof(bool) * TEST_BOUNDS_COUNT);
+	if (bounds_list == NULL || in_set == NULL) {
+		printf("out of memory\n");
+		failures++;
+		free(bounds_list);
+		free(in_set);
+		return;
+	}
+	for (i = 0; i < TEST_BOUNDS_COUNT; i++)
+		bounds_list[i] = __random_bounds();
+
+	/* Bulk load half of them, then grow the tree one bounds at a time */
+	int count = TEST_BOUNDS_COUNT / 2;
+	location_bounds_set_h set;
+	if (location_bounds_set_create_from_list(bounds_list, count, &set) != LOCATION_BOUNDS_ERROR_NONE) {
+		printf("location_bounds_set_create_from_list() failed\n");
+		failures++;
+		goto out;
+	}
+	for (i = 0; i < TEST_BOUNDS_COUNT; i++)
+		in_set[i] = i < count;
+	__check_tree("bulk load", set, count);
+	__check_queries("bulk load", set, bounds_list, in_set, TEST_BOUNDS_COUNT);
+
+	for (i = count; i < TEST_BOUNDS_COUNT; i++) {
+		TEST_CHECK(location_bounds_set_add(set, bounds_list[i]) == LOCATION_BOUNDS_ERROR_NONE, "add %d failed", i);
+		in_set[i] = TRUE;
+	}
+	count = TEST_BOUNDS_COUNT;
+	TEST_CHECK(location_bounds_set_add(set, bounds_list[0]) == LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, "duplicate add succeeded");
+	__check_tree("add", set, count);
+	__check_queries("add", set, bounds_list, in_set, TEST_BOUNDS_COUNT);
+
+	/* Random churn, each round removing most of the set and adding it back */
+	for (round = 0; round < TEST_ROUNDS; round++) {
+		char name[32];
+		for (i = 0; i < TEST_BOUNDS_COUNT; i++) {
+			int k = rand() % TEST_BOUNDS_COUNT;
+			if (in_set[k]) {
+				TEST_CHECK(location_bounds_set_remove(set, bounds_list[k]) == LOCATION_BOUNDS_ERROR_NONE, "remove %d failed", k);
+				in_set[k] = FALSE;
+				count--;
+			} else if (rand() % 4 == 0) {
+				TEST_CHECK(location_bounds_set_add(set, bounds_list[k]) == LOCATION_BOUNDS_ERROR_NONE, "add %d failed", k);
+				in_set[k] = TRUE;
+				count++;
+			}
+		}
+		snprintf(name, sizeof(name), "churn %d", round);
+		__check_tree(name, set, count);
+		__check_queries(name, set, bounds_list, in_set, TEST_BOUNDS_COUNT);
+	}
+
+	/* Empty it completely, the root must collapse back to a leaf */
+	for (i = 0; i < TEST_BOUNDS_COUNT; i++) {
+		if (in_set[i]) {
+			TEST_CHECK(location_bounds_set_remove(set, bounds_list[i]) == LOCATION_BOUNDS_ERROR_NONE, "remove %d failed", i);
+			in_set[i] = FALSE;
+		}
+	}
+	TEST_CHECK(location_bounds_set_remove(set, bounds_list[0]) == LOCATION_BOUNDS_ERROR_INVALID_PARAMETER, "removing a missing bounds succeeded");
+	__check_tree("empty", set, 0);
+	TEST_CHECK(((location_bounds_set_s *) set)->root->is_leaf, "[empty] root is not a leaf");
+	location_bounds_set_destroy(set);
+
+out:
+	for (i = 0; i < TEST_BOUNDS_COUNT; i++)
+		location_bounds_destroy(bounds_list[i]);
+	free(bounds_list);
+	free(in_set);
+}
+
+int main(int argc, char **argv)
+{
+	srand(1);
+	location_bounds_set_stress_test();
+	return test_report("location_bounds_set_test");
+}
@@ -0,0 +1,170 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdlib.h>
+#include <pthread.h>
+#include "location_test_util.h"
+
+/*
+* Overflow test of the dispatch queue. Position events are pushed to a dispatch thread whose callback
+* is held on the first event, so that the queue overflows by a known amount, then as fast as both
+* threads go. Every pushed event must be either delivered or counted as dropped or coalesced.
+*/
+
+#define TEST_QUEUE_SIZE		4
+#define TEST_HELD_COUNT		1000
+#define TEST_FREE_COUNT		200000
+
+static pthread_mutex_t test_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t test_cond = PTHREAD_COND_INITIALIZER;
+static bool is_holding;
+static bool is_held;
+static int delivered;
+static double last_value;
+static int order_errors;
+
+static void __position_cb(double latitude, double longitude, double altitude, time_t timestamp, void *user_data)
+{
+	if (latitude <= last_value)
+		order_errors++;
+	last_value = latitude;
+	delivered++;
+
+	pthread_mutex_lock(&test_lock);
+	if (is_holding) {
+		is_held = TRUE;
+		pthread_cond_broadcast(&test_cond);
+		while (is_holding)
+			pthread_cond_wait(&test_cond, &test_lock);
+	}
+	pthread_mutex_unlock(&test_lock);
+}
+
+static void __push(_location_dispatch_s *dispatch, int value)
+{
+	_location_event_s event;
+	memset(&event, 0, sizeof(_location_event_s));
+	event.type = _LOCATIONS_EVENT_TYPE_POSITION;
+	event.values[0] = value;
+	_location_dispatch_push(dispatch, &event);
+}
+
+static void __setup(location_manager_s *manager)
+{
+	memset(manager, 0, sizeof(location_manager_s));
+	manager->user_cb[_LOCATIONS_EVENT_TYPE_POSITION] = __position_cb;
+	delivered = 0;
+	last_value = -1;
+	order_errors = 0;
+}
+
+/* Holds the dispatch thread in the callback of event 0 while events 1 to count are pushed */
+static void __push_held(_location_dispatch_s *dispatch, int count)
+{
+	int i;
+	pthread_mutex_lock(&test_lock);
+	is_holding = TRUE;
+	is_held = FALSE;
+	pthread_mutex_unlock(&test_lock);
+
+	__push(dispatch, 0);
+	pthread_mutex_lock(&test_lock);
+	while (!is_held)
+		pthread_cond_wait(&test_cond, &test_lock);
+	pthread_mutex_unlock(&test_lock);
+
+	for (i = 1; i <= count; i++)
+		__push(dispatch, i);
+
+	pthread_mutex_lock(&test_lock);
+	is_holding = FALSE;
+	pthread_cond_broadcast(&test_cond);
+	pthread_mutex_unlock(&test_lock);
+}
+
+static void location_dispatch_drop_oldest_test(void)
+{
+	location_manager_s manager;
+	__setup(&manager);
+	_location_dispatch_s *dispatch = _location_dispatch_new(&manager, TEST_QUEUE_SIZE, LOCATIONS_DISPATCH_OVERFLOW_DROP_OLDEST);
+	if (dispatch == NULL) {
+		printf("[drop oldest] _location_dispatch_new() failed\n");
+		failures++;
+		return;
+	}
+	__push_held(dispatch, TEST_HELD_COUNT);
+	_location_dispatch_destroy(dispatch);
+
+	/* Event 0, then the newest of the full queue */
+	TEST_CHECK(delivered == 1 + TEST_QUEUE_SIZE, "[drop oldest] %d delivered, expected %d", delivered, 1 + TEST_QUEUE_SIZE);
+	TEST_CHECK(manager.dispatch_dropped == TEST_HELD_COUNT - TEST_QUEUE_SIZE, "[drop oldest] %u dropped, expected %d",
+		   manager.dispatch_dropped, TEST_HELD_COUNT - TEST_QUEUE_SIZE);
+	TEST_CHECK(last_value == TEST_HELD_COUNT, "[drop oldest] last delivered %.0f, expected %d", last_value, TEST_HELD_COUNT);
+	TEST_CHECK(order_errors == 0, "[drop oldest] %d events out of order", order_errors);
+}
+
+static void location_dispatch_coalesce_test(void)
+{
+	location_manager_s manager;
+	__setup(&manager);
+	_location_dispatch_s *dispatch = _location_dispatch_new(&manager, TEST_QUEUE_SIZE, LOCATIONS_DISPATCH_OVERFLOW_COALESCE);
+	if (dispatch == NULL) {
+		printf("[coalesce] _location_dispatch_new() failed\n");
+		failures++;
+		return;
+	}
+	__push_held(dispatch, TEST_HELD_COUNT);
+	_location_dispatch_destroy(dispatch);
+
+	/* Event 0, the full queue, then the newest of the coalesced ones */
+	TEST_CHECK(delivered == 2 + TEST_QUEUE_SIZE, "[coalesce] %d delivered, expected %d", delivered, 2 + TEST_QUEUE_SIZE);
+	TEST_CHECK(manager.dispatch_coalesced == TEST_HELD_COUNT - TEST_QUEUE_SIZE - 1, "[coalesce] %u coalesced, expected %d",
+		   manager.dispatch_coalesced, TEST_HELD_COUNT - TEST_QUEUE_SIZE - 1);
+	TEST_CHECK(last_value == TEST_HELD_COUNT, "[coalesce] last delivered %.0f, expected %d", last_value, TEST_HELD_COUNT);
+	TEST_CHECK(order_errors == 0, "[coalesce] %d events out of order", order_errors);
+}
+
+/* Both threads run freely, the producer overwrites slots the consumer is about to read */
+static void __race(const char *name, location_dispatch_overflow_e overflow)
+{
+	location_manager_s manager;
+	__setup(&manager);
+	_location_dispatch_s *dispatch = _location_dispatch_new(&manager, TEST_QUEUE_SIZE, overflow);
+	if (dispatch == NULL) {
+		printf("[%s] _location_dispatch_new() failed\n", name);
+		failures++;
+		return;
+	}
+	int i;
+	for (i = 1; i <= TEST_FREE_COUNT; i++)
+		__push(dispatch, i);
+	_location_dispatch_destroy(dispatch);
+
+	unsigned int lost = manager.dispatch_dropped + manager.dispatch_coalesced;
+	printf("[%s] %d delivered, %u dropped, %u coalesced\n", name, delivered, manager.dispatch_dropped, manager.dispatch_coalesced);
+	TEST_CHECK(delivered + lost == TEST_FREE_COUNT, "[%s] %d delivered and %u counted, expected %d in all", name, delivered, lost, TEST_FREE_COUNT);
+	TEST_CHECK(last_value == TEST_FREE_COUNT, "[%s] last delivered %.0f, expected %d", name, last_value, TEST_FREE_COUNT);
+	TEST_CHECK(order_errors == 0, "[%s] %d events out of order", name, order_errors);
+}
+
+int main(int argc, char **argv)
+{
+	location_dispatch_drop_oldest_test();
+	location_dispatch_coalesce_test();
+	__race("drop oldest race", LOCATIONS_DISPATCH_OVERFLOW_DROP_OLDEST);
+	__race("coalesce race", LOCATIONS_DISPATCH_OVERFLOW_COALESCE);
+	return test_report("location_dispatch_test");
+}
@@ -0,0 +1,148 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdlib.h>
+#include "location_test_util.h"
+
+/*
+* Duty cycle interval test. Fixes are fed to _location_duty_cycle_update() one interval apart, along
+* a track to the north, and the interval and the time the backend may sleep are checked after each one.
+*/
+
+#define TEST_MIN_INTERVAL	5
+#define TEST_MAX_INTERVAL	300
+
+typedef struct {
+	_location_duty_cycle_s duty;
+	double distance;	/* meters to the north of the start */
+	long long now;		/* nanoseconds */
+	bool no_velocity;	/* the fixes come without a velocity */
+} test_track_s;
+
+static void __setup(test_track_s *track, location_duty_cycle_policy_e policy)
+{
+	memset(track, 0, sizeof(test_track_s));
+	_location_duty_cycle_reset(&track->duty, policy, TEST_MIN_INTERVAL, TEST_MAX_INTERVAL);
+}
+
+/* Moves at speed (meters per second) for the current interval, then feeds the fix there */
+static int __update(test_track_s *track, double speed, double accuracy, location_fix_status_e status)
+{
+	int interval = track->duty.interval;
+	track->distance += speed * interval;
+	track->now += (long long) interval * 1000000000LL;
+
+	location_fix_s fix = test_fix_north(track->distance, accuracy);
+	fix.status = status;
+	return _location_duty_cycle_update(&track->duty, &fix, track->no_velocity ? -1 : speed, track->now);
+}
+
+static void location_duty_cycle_stationary_test(void)
+{
+	static const int expected[] = { 10, 20, 40, 80, 160, 300, 300 };
+	test_track_s track;
+	__setup(&track, LOCATIONS_DUTY_CYCLE_BALANCED);
+
+	/* The interval grows to the maximum by doubling, the backend sleeps once it reaches 30 seconds */
+	int i;
+	for (i = 0; i < (int) (sizeof(expected) / sizeof(expected[0])); i++) {
+		int sleep = __update(&track, 0, 10, LOCATIONS_FIX_2D);
+		TEST_CHECK(track.duty.interval == expected[i], "[stationary] fix %d : interval %d, expected %d", i, track.duty.interval, expected[i]);
+		int expected_sleep = expected[i] >= 30 ? expected[i] - 10 : 0;
+		TEST_CHECK(sleep == expected_sleep, "[stationary] fix %d : sleep %d, expected %d", i, sleep, expected_sleep);
+	}
+}
+
+static void location_duty_cycle_driving_test(void)
+{
+	test_track_s track;
+	__setup(&track, LOCATIONS_DUTY_CYCLE_POWER_SAVING);
+	while (track.duty.interval < TEST_MAX_INTERVAL)
+		__update(&track, 0, 10, LOCATIONS_FIX_2D);
+
+	/* 200 meters at 15 m/s, the interval drops at once */
+	int sleep = __update(&track, 15, 10, LOCATIONS_FIX_2D);
+	TEST_CHECK(track.duty.interval == 13, "[driving] interval %d, expected 13", track.duty.interval);
+	TEST_CHECK(sleep == 0, "[driving] sleep %d, expected 0", sleep);
+
+	/* Without a velocity the speed comes from the displacement, less the accuracy */
+	track.no_velocity = TRUE;
+	__update(&track, 15, 5, LOCATIONS_FIX_2D);
+	TEST_CHECK(track.duty.interval == 13, "[driving] interval %d from the displacement, expected 13", track.duty.interval);
+
+	/* Faster than the policy allows at the minimum interval */
+	__setup(&track, LOCATIONS_DUTY_CYCLE_HIGH_ACCURACY);
+	__update(&track, 30, 5, LOCATIONS_FIX_3D);
+	TEST_CHECK(track.duty.interval == TEST_MIN_INTERVAL, "[driving] interval %d, expected the minimum", track.duty.interval);
+}
+
+static void location_duty_cycle_low_accuracy_test(void)
+{
+	test_track_s track;
+	__setup(&track, LOCATIONS_DUTY_CYCLE_BALANCED);
+	while (track.duty.interval < TEST_MAX_INTERVAL)
+		__update(&track, 0, 10, LOCATIONS_FIX_2D);
+
+	/* More than twice the distance of the policy, no accuracy or no fix: back to the minimum, awake */
+	int sleep = __update(&track, 0, 101, LOCATIONS_FIX_2D);
+	TEST_CHECK(track.duty.interval == TEST_MIN_INTERVAL && sleep == 0, "[low accuracy] interval %d and sleep %d, expected %d and 0",
+		   track.duty.interval, sleep, TEST_MIN_INTERVAL);
+
+	__update(&track, 0, 10, LOCATIONS_FIX_2D);
+	sleep = __update(&track, 0, 0, LOCATIONS_FIX_2D);
+	TEST_CHECK(track.duty.interval == TEST_MIN_INTERVAL && sleep == 0, "[no accuracy] interval %d and sleep %d, expected %d and 0",
+		   track.duty.interval, sleep, TEST_MIN_INTERVAL);
+
+	__update(&track, 0, 10, LOCATIONS_FIX_2D);
+	sleep = __update(&track, 0, 10, LOCATIONS_FIX_NONE);
+	TEST_CHECK(track.duty.interval == TEST_MIN_INTERVAL && sleep == 0, "[no fix] interval %d and sleep %d, expected %d and 0",
+		   track.duty.interval, sleep, TEST_MIN_INTERVAL);
+
+	/* Twice the distance is still good enough */
+	__update(&track, 0, 100, LOCATIONS_FIX_2D);
+	TEST_CHECK(track.duty.interval == 2 * TEST_MIN_INTERVAL, "[low accuracy] interval %d at the limit, expected %d",
+		   track.duty.interval, 2 * TEST_MIN_INTERVAL);
+}
+
+static void location_duty_cycle_doubling_cap_test(void)
+{
+	static const int expected[] = { 10, 20, 40, 50, 50 };
+	test_track_s track;
+	__setup(&track, LOCATIONS_DUTY_CYCLE_BALANCED);
+
+	/* Walking at 1 m/s allows 50 seconds, reached by doubling from the minimum */
+	int i;
+	for (i = 0; i < (int) (sizeof(expected) / sizeof(expected[0])); i++) {
+		__update(&track, 1, 10, LOCATIONS_FIX_2D);
+		TEST_CHECK(track.duty.interval == expected[i], "[doubling] fix %d : interval %d, expected %d", i, track.duty.interval, expected[i]);
+	}
+
+	/* A short stop after a drive: the interval doubles again instead of jumping to the maximum */
+	__update(&track, 15, 10, LOCATIONS_FIX_2D);
+	TEST_CHECK(track.duty.interval == TEST_MIN_INTERVAL, "[doubling] interval %d while driving, expected %d", track.duty.interval, TEST_MIN_INTERVAL);
+	__update(&track, 0, 10, LOCATIONS_FIX_2D);
+	TEST_CHECK(track.duty.interval == 2 * TEST_MIN_INTERVAL, "[doubling] interval %d after the stop, expected %d",
+		   track.duty.interval, 2 * TEST_MIN_INTERVAL);
+}
+
+int main(int argc, char **argv)
+{
+	location_duty_cycle_stationary_test();
+	location_duty_cycle_driving_test();
+	location_duty_cycle_low_accuracy_test();
+	location_duty_cycle_doubling_cap_test();
+	return test_report("location_duty_cycle_test");
+}
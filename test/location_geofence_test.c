@@ -0,0 +1,199 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdlib.h>
+#include "location_test_util.h"
+
+/*
+* Geofence engine test. The fixes are fed to _location_geofence_update() directly, with a manager
+* that is never started, so the events only depend on the positions, accuracies and timestamps.
+*/
+
+#define TEST_RADIUS	100.0
+
+typedef struct {
+	int count[3];
+	location_bounds_h last_bounds;
+	location_manager_s *manager;
+	location_bounds_h *pair;	/* when set, the first event removes and destroys the other geofence of the pair */
+} test_events_s;
+
+static void __event_cb(location_bounds_h bounds, location_geofence_event_e event, const location_fix_s *fix, void *user_data)
+{
+	test_events_s *events = (test_events_s *) user_data;
+	events->count[event]++;
+	events->last_bounds = bounds;
+	if (events->pair) {
+		int other = (events->pair[0] == bounds) ? 1 : 0;
+		_location_geofence_remove(events->manager, (location_bounds_s *) events->pair[other]);
+		location_bounds_destroy(events->pair[other]);
+		events->pair[other] = NULL;
+		events->pair = NULL;
+	}
+}
+
+/* A fix north of the test center, at distance meters, taken at timestamp */
+static location_fix_s __fix(double distance, double accuracy, time_t timestamp)
+{
+	location_fix_s fix = test_fix_north(distance, accuracy);
+	fix.timestamp = timestamp;
+	return fix;
+}
+
+static location_bounds_h __circle(double radius)
+{
+	location_bounds_h bounds = NULL;
+	location_coords_s center;
+	center.latitude = TEST_LATITUDE;
+	center.longitude = TEST_LONGITUDE;
+	location_bounds_create_circle(center, radius, &bounds);
+	return bounds;
+}
+
+static void __setup(location_manager_s *manager, test_events_s *events, double buffer, int dwell_time)
+{
+	memset(manager, 0, sizeof(location_manager_s));
+	memset(events, 0, sizeof(test_events_s));
+	events->manager = manager;
+	manager->user_cb[_LOCATIONS_EVENT_TYPE_GEOFENCE] = __event_cb;
+	manager->user_data[_LOCATIONS_EVENT_TYPE_GEOFENCE] = events;
+	_location_geofence_reset(manager, buffer, dwell_time);
+}
+
+static void __update(location_manager_s *manager, location_fix_s fix)
+{
+	_location_geofence_update(manager, &fix);
+}
+
+static void location_geofence_enter_exit_test(void)
+{
+	location_manager_s manager;
+	test_events_s events;
+	__setup(&manager, &events, 0, 0);
+	location_bounds_h bounds = __circle(TEST_RADIUS);
+	_location_geofence_add(&manager, (location_bounds_s *) bounds);
+
+	__update(&manager, __fix(200, 0, 1));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_ENTER] == 0, "[enter] entered from outside");
+	__update(&manager, __fix(50, 0, 2));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_ENTER] == 1 && events.last_bounds == bounds, "[enter] not entered");
+	__update(&manager, __fix(0, 0, 3));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_ENTER] == 1, "[enter] entered twice");
+	__update(&manager, __fix(150, 0, 4));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_EXIT] == 1, "[exit] not left");
+
+	location_fix_s no_fix = __fix(0, 0, 5);
+	no_fix.status = LOCATIONS_FIX_NONE;
+	__update(&manager, no_fix);
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_ENTER] == 1, "[enter] entered without fix");
+
+	_location_geofence_destroy(&manager);
+	location_bounds_destroy(bounds);
+}
+
+static void location_geofence_hysteresis_test(void)
+{
+	location_manager_s manager;
+	test_events_s events;
+	__setup(&manager, &events, 20, 0);
+	location_bounds_h bounds = __circle(TEST_RADIUS);
+	_location_geofence_add(&manager, (location_bounds_s *) bounds);
+
+	/* Entering needs buffer plus accuracy inside the edge */
+	__update(&manager, __fix(90, 0, 1));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_ENTER] == 0, "[hysteresis] entered within the buffer");
+	__update(&manager, __fix(70, 20, 2));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_ENTER] == 0, "[hysteresis] entered within the buffer plus accuracy");
+	__update(&manager, __fix(70, 5, 3));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_ENTER] == 1, "[hysteresis] not entered beyond the buffer plus accuracy");
+
+	/* Leaving needs as much outside */
+	__update(&manager, __fix(110, 0, 4));
+	__update(&manager, __fix(130, 15, 5));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_EXIT] == 0, "[hysteresis] left within the buffer plus accuracy");
+	__update(&manager, __fix(90, 0, 6));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_ENTER] == 1, "[hysteresis] entered again without leaving");
+	__update(&manager, __fix(130, 5, 7));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_EXIT] == 1, "[hysteresis] not left beyond the buffer plus accuracy");
+
+	/* A geofence smaller than the accuracy is not entered */
+	__update(&manager, __fix(0, 150, 8));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_ENTER] == 1, "[hysteresis] entered with an accuracy larger than the geofence");
+
+	_location_geofence_destroy(&manager);
+	location_bounds_destroy(bounds);
+}
+
+static void location_geofence_dwell_test(void)
+{
+	location_manager_s manager;
+	test_events_s events;
+	__setup(&manager, &events, 0, 60);
+	location_bounds_h bounds = __circle(TEST_RADIUS);
+	_location_geofence_add(&manager, (location_bounds_s *) bounds);
+
+	__update(&manager, __fix(0, 0, 1000));
+	__update(&manager, __fix(0, 0, 1059));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_DWELL] == 0, "[dwell] reported before the dwell time");
+	__update(&manager, __fix(0, 0, 1060));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_DWELL] == 1, "[dwell] not reported at the dwell time");
+	__update(&manager, __fix(0, 0, 1200));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_DWELL] == 1, "[dwell] reported twice for one entry");
+
+	/* A new entry starts a new dwell time */
+	__update(&manager, __fix(200, 0, 1210));
+	__update(&manager, __fix(0, 0, 1220));
+	__update(&manager, __fix(0, 0, 1250));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_DWELL] == 1, "[dwell] reported from the previous entry");
+	__update(&manager, __fix(0, 0, 1280));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_DWELL] == 2, "[dwell] not reported after the new entry");
+
+	_location_geofence_destroy(&manager);
+	location_bounds_destroy(bounds);
+}
+
+static void location_geofence_remove_in_callback_test(void)
+{
+	location_manager_s manager;
+	test_events_s events;
+	__setup(&manager, &events, 0, 0);
+	location_bounds_h pair[2];
+	pair[0] = __circle(TEST_RADIUS);
+	pair[1] = __circle(2 * TEST_RADIUS);
+	_location_geofence_add(&manager, (location_bounds_s *) pair[0]);
+	_location_geofence_add(&manager, (location_bounds_s *) pair[1]);
+
+	/* Both are entered by the same fix, the first event destroys the other geofence */
+	events.pair = pair;
+	__update(&manager, __fix(0, 0, 1));
+	TEST_CHECK(events.count[LOCATIONS_GEOFENCE_ENTER] == 1, "[remove] %d events delivered, expected 1", events.count[LOCATIONS_GEOFENCE_ENTER]);
+	TEST_CHECK(events.last_bounds == pair[0] || events.last_bounds == pair[1], "[remove] event for the removed geofence");
+
+	_location_geofence_destroy(&manager);
+	if (pair[0])
+		location_bounds_destroy(pair[0]);
+	if (pair[1])
+		location_bounds_destroy(pair[1]);
+}
+
+int main(int argc, char **argv)
+{
+	location_geofence_enter_exit_test();
+	location_geofence_hysteresis_test();
+	location_geofence_dwell_test();
+	location_geofence_remove_in_callback_test();
+	return test_report("location_geofence_test");
+}
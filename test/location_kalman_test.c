@@ -0,0 +1,91 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdlib.h>
+#include "location_test_util.h"
+
+/*
+* Convergence test of the Kalman filter. A track is sampled once a second with an error of up to
+* 20 meters on each axis, together with its velocity as the GPS reports it, and the mean distance
+* of the filtered positions to the track is compared with the mean distance of the raw fixes once
+* the filter has settled.
+*/
+
+#define TEST_FIX_COUNT		600
+#define TEST_SETTLE_COUNT	100	/* fixes before the filtered error is measured */
+#define TEST_NOISE		20.0	/* meters, on each axis */
+#define TEST_ACCELERATION	0.5	/* meters per second squared */
+
+static double __noise(void)
+{
+	return TEST_NOISE * (2.0 * rand() / (double)RAND_MAX - 1.0);
+}
+
+static double __distance(double latitude_a, double longitude_a, double latitude_b, double longitude_b)
+{
+	double north = LOCATIONS_DEG_TO_RAD(latitude_a - latitude_b) * LOCATIONS_EARTH_RADIUS_MEAN;
+	double east = LOCATIONS_DEG_TO_RAD(longitude_a - longitude_b) * cos(LOCATIONS_DEG_TO_RAD(latitude_b)) * LOCATIONS_EARTH_RADIUS_MEAN;
+	return sqrt(north * north + east * east);
+}
+
+/* Runs the filter along a straight track at speed (meters per second) to the north */
+static void __converge(const char *name, double speed)
+{
+	_location_kalman_s filter;
+	_location_kalman_reset(&filter, TEST_ACCELERATION);
+	double meters_per_degree = LOCATIONS_DEG_TO_RAD(1) * LOCATIONS_EARTH_RADIUS_MEAN;
+	double raw_error = 0;
+	double filtered_error = 0;
+	int i;
+
+	for (i = 0; i < TEST_FIX_COUNT; i++) {
+		gint64 now = (gint64) i * 1000000;
+		double latitude = TEST_LATITUDE + speed * i / meters_per_degree;
+		double longitude = TEST_LONGITUDE;
+
+		location_fix_s fix;
+		memset(&fix, 0, sizeof(location_fix_s));
+		fix.status = LOCATIONS_FIX_2D;
+		fix.latitude = latitude + __noise() / meters_per_degree;
+		fix.longitude = longitude + __noise() / (meters_per_degree * cos(LOCATIONS_DEG_TO_RAD(latitude)));
+		fix.horizontal_accuracy = TEST_NOISE;
+		_location_kalman_update_position(&filter, &fix, now);
+		_location_kalman_update_velocity(&filter, speed * 3.6, 0, 0, now);
+
+		location_fix_s smoothed;
+		memset(&smoothed, 0, sizeof(location_fix_s));
+		_location_kalman_get_fix(&filter, &smoothed);
+		if (i >= TEST_SETTLE_COUNT) {
+			raw_error += __distance(fix.latitude, fix.longitude, latitude, longitude);
+			filtered_error += __distance(smoothed.latitude, smoothed.longitude, latitude, longitude);
+		}
+	}
+
+	raw_error /= TEST_FIX_COUNT - TEST_SETTLE_COUNT;
+	filtered_error /= TEST_FIX_COUNT - TEST_SETTLE_COUNT;
+	printf("[%s] mean error : raw %.1f m, filtered %.1f m\n", name, raw_error, filtered_error);
+	TEST_CHECK(raw_error > 12 && raw_error < 18, "[%s] unexpected raw error %.1f m", name, raw_error);
+	TEST_CHECK(filtered_error < 4, "[%s] filtered error %.1f m, expected less than 4 m", name, filtered_error);
+}
+
+int main(int argc, char **argv)
+{
+	srand(1);
+	__converge("stationary", 0);
+	__converge("walking", 1.5);
+	__converge("driving", 15);
+	return test_report("location_kalman_test");
+}
@@ -0,0 +1,58 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef __LOCATION_TEST_UTIL_H__
+#define __LOCATION_TEST_UTIL_H__
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <locations.h>
+#include <locations_private.h>
+
+/* Checks of the test programs: a failed check is printed and counted, test_report() gives the exit status */
+
+#define TEST_LATITUDE		37.258
+#define TEST_LONGITUDE		127.056
+
+static int failures;
+
+#define TEST_CHECK(condition, ...) \
+	do { if (!(condition)) { printf(__VA_ARGS__); printf("\n"); failures++; } } while (0)
+
+static inline int test_report(const char *name)
+{
+	if (failures) {
+		printf("%s : %d failures\n", name, failures);
+		return 1;
+	}
+	printf("%s : passed\n", name);
+	return 0;
+}
+
+/* A 2D fix at distance meters to the north of the test point */
+static inline location_fix_s test_fix_north(double distance, double accuracy)
+{
+	location_fix_s fix;
+	memset(&fix, 0, sizeof(location_fix_s));
+	fix.status = LOCATIONS_FIX_2D;
+	fix.latitude = TEST_LATITUDE + distance / LOCATIONS_EARTH_RADIUS_MEAN * 180.0 / M_PI;
+	fix.longitude = TEST_LONGITUDE;
+	fix.horizontal_accuracy = accuracy;
+	return fix;
+}
+
+#endif /* __LOCATION_TEST_UTIL_H__ */